@@ -0,0 +1,636 @@
+<?hh
+
+///////////////////////////////////////////////////////////////////////////////
+/// MappedVariantMap Class Definition ////////////////////////////////////////
+/////////////////////////////////////////////////////////////////////////////
+
+/**
+ * A read-only VariantMap over a file, the layout is little-endian and every offset is a 32-bit byte position:
+ *   header                    "HVM\x01", entry count, slot count, slot table offset
+ *   entries                   key length, key, value length, value as a header-less VariantBinary node
+ *   slot table                slot count pairs of the crc32 of the lowercase key and the entry offset plus one, zero for an empty slot
+ * Lookups hash into the slot table and read only the probed slots and the matching entry, so the data stays in the OS page cache
+ * and is shared by every process that opens the same file instead of being copied into each heap
+ */
+class MappedVariantMap extends VariantMap
+{
+	//////////////////////////////////////////////////////////////////////////////
+	/// Constants ///////////////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////
+
+	/**
+	 * This constant contains the magic the file starts with, the last byte is the format version
+	 * @name MappedVariantMap::Magic
+	 * @var string
+	 */
+	const string Magic = "HVM\x01";
+
+	/**
+	 * This constant contains the size of the header in bytes
+	 * @name MappedVariantMap::HeaderSize
+	 * @var int
+	 */
+	const int HeaderSize = 16;
+
+	/**
+	 * This constant contains the number of slot table values packed and written at a time, so pack() never gets a huge argument list
+	 * @name MappedVariantMap::SlotChunk
+	 * @var int
+	 */
+	const int SlotChunk = 4096;
+
+	//////////////////////////////////////////////////////////////////////////////
+	/// Properties //////////////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////
+
+	/**
+	 * This property contains the classes values stored as serialized data may hold objects of
+	 * @access protected
+	 * @name MappedVariantMap::$mAllowedClasses
+	 * @var array<string>
+	 */
+	protected array<string> $mAllowedClasses = [];
+
+	/**
+	 * This property contains the number of entries in the file
+	 * @access protected
+	 * @name MappedVariantMap::$mCount
+	 * @var int
+	 */
+	protected int $mCount                    = 0;
+
+	/**
+	 * This property contains the path of the file
+	 * @access protected
+	 * @name MappedVariantMap::$mFile
+	 * @var string
+	 */
+	protected string $mFile                  = '';
+
+	/**
+	 * This property contains the open handle to the file
+	 * @access protected
+	 * @name MappedVariantMap::$mHandle
+	 * @var resource
+	 */
+	protected mixed $mHandle                 = null;
+
+	/**
+	 * This property contains the number of slots in the slot table
+	 * @access protected
+	 * @name MappedVariantMap::$mSlotCount
+	 * @var int
+	 */
+	protected int $mSlotCount                = 0;
+
+	/**
+	 * This property contains the position of the slot table, which is also where the entries end
+	 * @access protected
+	 * @name MappedVariantMap::$mSlotOffset
+	 * @var int
+	 */
+	protected int $mSlotOffset               = 0;
+
+	//////////////////////////////////////////////////////////////////////////////
+	/// Constructor /////////////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////
+
+	/**
+	 * This method opens a file written by MappedVariantMap::write()
+	 * @access public
+	 * @name MappedVariantMap::__construct()
+	 * @param string $strFile
+	 * @param array<string> $arrAllowedClasses [[]] The classes VCustom payloads may hold objects of, others come back as __PHP_Incomplete_Class
+	 * @return void
+	 * @throws Exception
+	 */
+	public function __construct(string $strFile, array<string> $arrAllowedClasses = []) : void
+	{
+		// Set the allowed classes into the instance
+		$this->mAllowedClasses = $arrAllowedClasses;
+		// Open the file
+		$this->mHandle = fopen($strFile, 'rb');
+		// Make sure the file opened
+		if ($this->mHandle === false) {
+			// Throw an exception
+			throw new Exception('Unable to open '.$strFile.' for reading.');
+		}
+		// Set the path into the instance
+		$this->mFile = $strFile;
+		// Read the header
+		$strHeader   = $this->readAt(0, self::HeaderSize);
+		// Check the magic
+		if (substr($strHeader, 0, 4) !== self::Magic) {
+			// Throw an exception
+			throw new Exception($strFile.' is not a MappedVariantMap file.');
+		}
+		// Unpack the header
+		$arrHeader = unpack('Vcount/Vslots/Voffset', substr($strHeader, 4));
+		// Set the header into the instance
+		$this->mCount      = $arrHeader['count'];
+		$this->mSlotCount  = $arrHeader['slots'];
+		$this->mSlotOffset = $arrHeader['offset'];
+	}
+
+	/**
+	 * This method closes the file
+	 * @access public
+	 * @name MappedVariantMap::__destruct()
+	 * @return void
+	 */
+	public function __destruct() : void
+	{
+		// Check for an open handle
+		if (is_resource($this->mHandle)) {
+			// Close the file
+			fclose($this->mHandle);
+		}
+	}
+
+	//////////////////////////////////////////////////////////////////////////////
+	/// Public Static Methods ///////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////
+
+	/**
+	 * This method opens a file written by MappedVariantMap::write()
+	 * @access public
+	 * @name MappedVariantMap::fromFile()
+	 * @param string $strFile
+	 * @param array<string> $arrAllowedClasses [[]] The classes VCustom payloads may hold objects of, others come back as __PHP_Incomplete_Class
+	 * @return MappedVariantMap
+	 * @static
+	 */
+	public static function fromFile(string $strFile, array<string> $arrAllowedClasses = []) : MappedVariantMap
+	{
+		// Return the new instance
+		return new self($strFile, $arrAllowedClasses);
+	}
+
+	/**
+	 * This method writes a VariantMap to a file MappedVariantMap can open, the file is replaced atomically
+	 * @access public
+	 * @name MappedVariantMap::write()
+	 * @param string $strFile
+	 * @param VariantMap $varSource
+	 * @return int The number of bytes written
+	 * @static
+	 * @throws Exception
+	 */
+	public static function write(string $strFile, VariantMap $varSource) : int
+	{
+		// Open a temporary file next to the target
+		$strTemporary = $strFile.'.'.getmypid().'.tmp';
+		$rscFile      = fopen($strTemporary, 'wb');
+		// Make sure the file opened
+		if ($rscFile === false) {
+			// Throw an exception
+			throw new Exception('Unable to open '.$strTemporary.' for writing.');
+		}
+		// Localize whether or not the target was replaced
+		$blnReplaced = false;
+		// Write the file, anything that throws leaves no temporary file or handle behind
+		try {
+			// Reserve the header
+			self::writeBytes($rscFile, str_repeat("\x00", self::HeaderSize));
+			// Localize the position and the hash and position of each entry
+			$intOffset  = self::HeaderSize;
+			$vecHashes  = Vector {};
+			$vecOffsets = Vector {};
+			// Iterate over the map
+			foreach ($varSource->getIterator() as $mixKey => $varValue) {
+				// Encode the entry
+				$strKey   = (string) $mixKey;
+				$strValue = VariantBinary::encodeBare($varValue);
+				$strEntry = pack('V', strlen($strKey)).$strKey.pack('V', strlen($strValue)).$strValue;
+				// Make sure the entry is addressable
+				if (($intOffset + strlen($strEntry)) > 0xFFFFFFFE) {
+					// Throw an exception
+					throw new Exception('MappedVariantMap files are limited to 4 GiB.');
+				}
+				// Write the entry
+				self::writeBytes($rscFile, $strEntry);
+				// Keep the hash and the position
+				$vecHashes->add(crc32(strtolower($strKey)));
+				$vecOffsets->add($intOffset);
+				// Move the position
+				$intOffset += strlen($strEntry);
+			}
+			// Size the slot table to a power of two at most half full
+			$intSlots = 8;
+			// Iterate until the table is large enough
+			while ($intSlots < ($vecHashes->count() * 2)) {
+				// Double the table
+				$intSlots *= 2;
+			}
+			// Create the empty slot table
+			$vecSlots = Vector {};
+			$vecSlots->resize($intSlots * 2, 0);
+			// Iterate over the entries
+			foreach ($vecHashes->getIterator() as $intEntry => $intHash) {
+				// Probe for a free slot
+				$intSlot = ($intHash % $intSlots);
+				// Iterate until a free slot is found
+				while ($vecSlots->at(($intSlot * 2) + 1) !== 0) {
+					// Move to the next slot
+					$intSlot = (($intSlot + 1) % $intSlots);
+				}
+				// Fill the slot
+				$vecSlots->set($intSlot * 2, $intHash);
+				$vecSlots->set(($intSlot * 2) + 1, ($vecOffsets->at($intEntry) + 1));
+			}
+			// Localize the slot table values
+			$arrSlots = $vecSlots->toArray();
+			// Write the slot table a chunk at a time
+			for ($intStart = 0; $intStart < count($arrSlots); $intStart += self::SlotChunk) {
+				// Pack and write the chunk
+				self::writeBytes($rscFile, call_user_func_array('pack', array_merge(['V*'], array_slice($arrSlots, $intStart, self::SlotChunk))));
+			}
+			// Write the header
+			fseek($rscFile, 0);
+			self::writeBytes($rscFile, self::Magic.pack('VVV', $vecHashes->count(), $intSlots, $intOffset));
+			// Close the file, buffered bytes that cannot be flushed fail here
+			$blnClosed = fclose($rscFile);
+			$rscFile   = null;
+			// Make sure the file is complete and replace the target
+			if (($blnClosed === false) || (rename($strTemporary, $strFile) === false)) {
+				// Throw an exception
+				throw new Exception('Unable to replace '.$strFile.' with '.$strTemporary.'.');
+			}
+			// The target is replaced
+			$blnReplaced = true;
+			// We're done
+			return ($intOffset + ($intSlots * 8));
+		} finally {
+			// Check for a write that did not finish
+			if ($blnReplaced === false) {
+				// Check for an open file
+				if ($rscFile !== null) {
+					// Close the file
+					fclose($rscFile);
+				}
+				// Check for the temporary file
+				if (file_exists($strTemporary)) {
+					// Drop the temporary file
+					unlink($strTemporary);
+				}
+			}
+		}
+	}
+
+	//////////////////////////////////////////////////////////////////////////////
+	/// Protected Static Methods ////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////
+
+	/**
+	 * This method writes a string to a file, short and failed writes throw
+	 * @access protected
+	 * @name MappedVariantMap::writeBytes()
+	 * @param resource $rscFile
+	 * @param string $strBytes
+	 * @return void
+	 * @static
+	 * @throws Exception
+	 */
+	protected static function writeBytes(resource $rscFile, string $strBytes) : void
+	{
+		// Write the bytes
+		$mixWritten = fwrite($rscFile, $strBytes);
+		// Make sure every byte was written
+		if ($mixWritten !== strlen($strBytes)) {
+			// Throw an exception
+			throw new Exception('Unable to write '.strlen($strBytes).' bytes to a MappedVariantMap file.');
+		}
+	}
+
+	//////////////////////////////////////////////////////////////////////////////
+	/// Protected Methods ///////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////
+
+	/**
+	 * This method walks the entries in the file, there is nothing stored in memory so each value is decoded as it is reached
+	 * @access protected
+	 * @name MappedVariantMap::entryIterator()
+	 * @return KeyedIterator<string, mixed>
+	 */
+	protected function entryIterator() : KeyedIterator<string, mixed>
+	{
+		// Return the decoding iterator
+		return $this->getIterator();
+	}
+
+	/**
+	 * This method finds the entry for a key, an exact match wins over a case-insensitive one
+	 * @access protected
+	 * @name MappedVariantMap::lookup()
+	 * @param string $strKey
+	 * @return HH\Pair<string, HH\Pair<int, int>>|null
+	 */
+	protected function lookup(string $strKey) : ?Pair<string, Pair<int, int>>
+	{
+		// Check for an empty table
+		if ($this->mSlotCount === 0) {
+			// We're done
+			return null;
+		}
+		// Hash the key
+		$strFolded = strtolower($strKey);
+		$intHash   = crc32($strFolded);
+		// Localize the case-insensitive match
+		$parFolded = null;
+		// Iterate over the probe sequence
+		for ($intSlot = ($intHash % $this->mSlotCount); true; $intSlot = (($intSlot + 1) % $this->mSlotCount)) {
+			// Read the slot
+			$arrSlot = unpack('Vhash/Voffset', $this->readAt($this->mSlotOffset + ($intSlot * 8), 8));
+			// Check for the end of the probe sequence
+			if ($arrSlot['offset'] === 0) {
+				// Return the case-insensitive match, if any
+				return $parFolded;
+			}
+			// Check the hash
+			if ($arrSlot['hash'] !== $intHash) {
+				// Next slot
+				continue;
+			}
+			// Read the entry
+			$parEntry = $this->readEntry($arrSlot['offset'] - 1);
+			// Check for an exact match
+			if ($parEntry[0] === $strKey) {
+				// We're done
+				return $parEntry;
+			}
+			// Check for a case-insensitive match
+			if (($parFolded === null) && (strtolower($parEntry[0]) === $strFolded)) {
+				// Keep the match, an exact one may still follow
+				$parFolded = $parEntry;
+			}
+		}
+	}
+
+	/**
+	 * This method reads bytes from the file
+	 * @access protected
+	 * @name MappedVariantMap::readAt()
+	 * @param int $intOffset
+	 * @param int $intLength
+	 * @return string
+	 * @throws Exception
+	 */
+	protected function readAt(int $intOffset, int $intLength) : string
+	{
+		// Check for nothing to read
+		if ($intLength === 0) {
+			// We're done
+			return '';
+		}
+		// Move to the position
+		fseek($this->mHandle, $intOffset);
+		// Read the bytes
+		$strData = fread($this->mHandle, $intLength);
+		// Make sure everything was read
+		if (($strData === false) || (strlen($strData) !== $intLength)) {
+			// Throw an exception
+			throw new Exception('Unexpected end of '.$this->mFile.'.');
+		}
+		// We're done
+		return $strData;
+	}
+
+	/**
+	 * This method reads an entry's key and the position and length of its value
+	 * @access protected
+	 * @name MappedVariantMap::readEntry()
+	 * @param int $intOffset
+	 * @return HH\Pair<string, HH\Pair<int, int>>
+	 */
+	protected function readEntry(int $intOffset) : Pair<string, Pair<int, int>>
+	{
+		// Read the key
+		$intKeyLength   = unpack('V', $this->readAt($intOffset, 4))[1];
+		$strKey         = $this->readAt($intOffset + 4, $intKeyLength);
+		// Read the value length
+		$intValueOffset = ($intOffset + 8 + $intKeyLength);
+		$intValueLength = unpack('V', $this->readAt($intValueOffset - 4, 4))[1];
+		// We're done
+		return Pair { $strKey, Pair { $intValueOffset, $intValueLength } };
+	}
+
+	//////////////////////////////////////////////////////////////////////////////
+	/// Public Methods //////////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////
+
+	/**
+	 * This method looks a key up with case-insensitivity and decodes only its value, Variant::Factory(null) elsewise
+	 * @access public
+	 * @name MappedVariantMap::at()
+	 * @param string $strKey
+	 * @return Variant
+	 */
+	public function at(string $strKey) : Variant
+	{
+		// Find the entry
+		$parEntry = $this->lookup($strKey);
+		// Check for an entry
+		if ($parEntry === null) {
+			// Return an empty variant
+			return Variant::Factory(null);
+		}
+		// Return the decoded value
+		return VariantBinary::decodeAt($this->readAt($parEntry[1][0], $parEntry[1][1]), 0, $this->mAllowedClasses);
+	}
+
+	/**
+	 * This method is not available, the map is read-only
+	 * @access public
+	 * @name MappedVariantMap::clear()
+	 * @return VariantMap $this
+	 * @throws Exception
+	 */
+	public function clear() : VariantMap
+	{
+		// Throw an exception
+		throw new Exception('MappedVariantMap is read-only.');
+	}
+
+	/**
+	 * This method returns the number of keys in the file
+	 * @access public
+	 * @name MappedVariantMap::count()
+	 * @return int
+	 */
+	public function count() : int
+	{
+		// Return the count
+		return $this->mCount;
+	}
+
+	/**
+	 * This method walks the entries in the order they were written and decodes each value as the iteration reaches it
+	 * @access public
+	 * @name MappedVariantMap::getIterator()
+	 * @return KeyedIterator<string, Variant>
+	 */
+	public function getIterator() : KeyedIterator<string, Variant>
+	{
+		// Start at the first entry
+		$intOffset = self::HeaderSize;
+		// Iterate until the slot table
+		while ($intOffset < $this->mSlotOffset) {
+			// Read the entry
+			$parEntry = $this->readEntry($intOffset);
+			// Yield the decoded value
+			yield $parEntry[0] => VariantBinary::decodeAt($this->readAt($parEntry[1][0], $parEntry[1][1]), 0, $this->mAllowedClasses);
+			// Move to the next entry
+			$intOffset = ($parEntry[1][0] + $parEntry[1][1]);
+		}
+	}
+
+	/**
+	 * This method returns whether or not the file has no keys
+	 * @access public
+	 * @name MappedVariantMap::isEmpty()
+	 * @return bool
+	 */
+	public function isEmpty() : bool
+	{
+		// Return the empty status
+		return ($this->mCount === 0);
+	}
+
+	/**
+	 * This method is not available, the map is read-only
+	 * @access public
+	 * @name MappedVariantMap::remove()
+	 * @param string $strKey
+	 * @return VariantMap $this
+	 * @throws Exception
+	 */
+	public function remove(string $strKey) : VariantMap
+	{
+		// Throw an exception
+		throw new Exception('MappedVariantMap is read-only.');
+	}
+
+	/**
+	 * This method searches the file for a specified key with case-insensitivity, if one is found the actual key name is returned, null elsewise
+	 * @access public
+	 * @name MappedVariantMap::search()
+	 * @param string $strKey
+	 * @return string
+	 */
+	public function search(string $strKey) : ?string
+	{
+		// Find the entry
+		$parEntry = $this->lookup($strKey);
+		// Return the real key
+		return (($parEntry === null) ? null : $parEntry[0]);
+	}
+
+	/**
+	 * This method is not available, the map is read-only
+	 * @access public
+	 * @name MappedVariantMap::set()
+	 * @param string $strKey
+	 * @param mixed $mixValue
+	 * @return VariantMap $this
+	 * @throws Exception
+	 */
+	public function set(string $strKey, mixed $mixValue) : VariantMap
+	{
+		// Throw an exception
+		throw new Exception('MappedVariantMap is read-only.');
+	}
+
+	/**
+	 * This method is not available, the map is read-only
+	 * @access public
+	 * @name MappedVariantMap::setVariant()
+	 * @param string $strKey
+	 * @param Variant $varValue
+	 * @return VariantMap $this
+	 * @throws Exception
+	 */
+	public function setVariant(string $strKey, Variant $varValue) : VariantMap
+	{
+		// Throw an exception
+		throw new Exception('MappedVariantMap is read-only.');
+	}
+
+	//////////////////////////////////////////////////////////////////////////////
+	/// Converters //////////////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////
+
+	/**
+	 * This method returns the keys in the file as an array
+	 * @access public
+	 * @name MappedVariantMap::toKeysArray()
+	 * @return array<string>
+	 */
+	public function toKeysArray() : array<string>
+	{
+		// Create the response array
+		$arrKeys   = [];
+		// Start at the first entry
+		$intOffset = self::HeaderSize;
+		// Iterate until the slot table
+		while ($intOffset < $this->mSlotOffset) {
+			// Read the entry
+			$parEntry  = $this->readEntry($intOffset);
+			// Add the key
+			$arrKeys[] = $parEntry[0];
+			// Move to the next entry
+			$intOffset = ($parEntry[1][0] + $parEntry[1][1]);
+		}
+		// We're done
+		return $arrKeys;
+	}
+
+	/**
+	 * This method returns the values in their original type as an array, every value is decoded
+	 * @access public
+	 * @name MappedVariantMap::toValuesArray()
+	 * @return array<mixed>
+	 */
+	public function toValuesArray() : array<mixed>
+	{
+		// Create the response array
+		$arrValues = [];
+		// Iterate over the entries
+		foreach ($this->getIterator() as $varValue) {
+			// Add the raw value
+			$arrValues[] = $varValue->getData();
+		}
+		// We're done
+		return $arrValues;
+	}
+
+	/**
+	 * This method returns the data as an array with the values in Variant form, every value is decoded
+	 * @access public
+	 * @name MappedVariantMap::toVariantArray()
+	 * @return array<string, Variant>
+	 */
+	public function toVariantArray() : array<string, Variant>
+	{
+		// Create the response array
+		$arrData = [];
+		// Iterate over the entries
+		foreach ($this->getIterator() as $strKey => $varValue) {
+			// Add the value
+			$arrData[$strKey] = $varValue;
+		}
+		// We're done
+		return $arrData;
+	}
+
+	/**
+	 * This method returns the values as an array of Variants, every value is decoded
+	 * @access public
+	 * @name MappedVariantMap::toVariantValuesArray()
+	 * @return array<Variant>
+	 */
+	public function toVariantValuesArray() : array<Variant>
+	{
+		// Return the values
+		return array_values($this->toVariantArray());
+	}
+}
@@ -0,0 +1,93 @@
+<?hh
+
+///////////////////////////////////////////////////////////////////////////////
+/// SchemaVariant Class Definition ///////////////////////////////////////////
+/////////////////////////////////////////////////////////////////////////////
+
+/**
+ * A view of one column in a SchemaVariantMap, the value is typed with its declared type so getType() never detects it
+ * Changes made through the view are written back into the row with SchemaVariantMap::set(), so they are coerced like any other write
+ * The row keeps its values raw and hands out a new view on each access, so take a new view after the row changes
+ */
+class SchemaVariant extends Variant
+{
+	//////////////////////////////////////////////////////////////////////////////
+	/// Properties //////////////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////
+
+	/**
+	 * This property contains the name of the column the view is of
+	 * @access protected
+	 * @name SchemaVariant::$mKey
+	 * @var string
+	 */
+	protected string $mKey             = '';
+
+	/**
+	 * This property contains the row the view writes back into
+	 * @access protected
+	 * @name SchemaVariant::$mRow
+	 * @var SchemaVariantMap
+	 */
+	protected ?SchemaVariantMap $mRow  = null;
+
+	//////////////////////////////////////////////////////////////////////////////
+	/// Constructor /////////////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////
+
+	/**
+	 * This method sets up the view of a column with its raw value and declared type
+	 * @access public
+	 * @name SchemaVariant::__construct()
+	 * @param SchemaVariantMap $varRow
+	 * @param string $strKey
+	 * @param mixed $mixData
+	 * @param Type $typeData
+	 * @return void
+	 */
+	public function __construct(SchemaVariantMap $varRow, string $strKey, mixed $mixData, Type $typeData) : void
+	{
+		// Set the data into the instance
+		parent::__construct($mixData);
+		// Preset the type
+		$this->mType = $typeData;
+		// Set the row and column into the instance
+		$this->mKey  = $strKey;
+		$this->mRow  = $varRow;
+	}
+
+	//////////////////////////////////////////////////////////////////////////////
+	/// Public Methods //////////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////
+
+	/**
+	 * This method replaces targets in the value and writes the result back into the row, which coerces it to the declared type
+	 * @access public
+	 * @name SchemaVariant::replace()
+	 * @param string $mixTarget
+	 * @param string $mixReplacement
+	 * @param bool $blnCaseSensitive [false]
+	 * @return Variant $this
+	 * @throws Exception
+	 */
+	public function replace(string $strTarget, string $strReplacement, bool $blnCaseSensitive = false) : Variant
+	{
+		// Make sure we can convert
+		if ($this->can(Type::VString) === false) {
+			// We're done
+			return $this;
+		}
+		// Write the changed value through the row and take a view of what was stored
+		$varValue    = $this->mRow
+			->set($this->mKey, $this->replaceNonVolatile($strTarget, $strReplacement, $blnCaseSensitive))
+			->at($this->mKey);
+		// Reset the data to the coerced value
+		$this->mData = $varValue->mData;
+		// The data has changed, drop anything derived from it
+		$this->invalidate();
+		// Keep the declared type
+		$this->mType = $varValue->mType;
+		// We're done
+		return $this;
+	}
+}
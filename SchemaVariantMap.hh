@@ -0,0 +1,452 @@
+<?hh
+
+///////////////////////////////////////////////////////////////////////////////
+/// SchemaVariantMap Class Definition ////////////////////////////////////////
+/////////////////////////////////////////////////////////////////////////////
+
+/**
+ * A VariantMap with the fixed layout of a VariantSchema, the values are kept raw in positional slots coerced to their declared types
+ * Keys resolve to slots through the schema, values are handed out as SchemaVariant views with their declared type so getType() never detects them
+ * The slots stay raw, each access makes a new view and changes made through a view are written back with set(), so they are coerced as well
+ */
+class SchemaVariantMap extends VariantMap
+{
+	//////////////////////////////////////////////////////////////////////////////
+	/// Properties //////////////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////
+
+	/**
+	 * This property contains the layout of the row
+	 * @access protected
+	 * @name SchemaVariantMap::$mSchema
+	 * @var VariantSchema
+	 */
+	protected ?VariantSchema $mSchema = null;
+
+	/**
+	 * This property contains the raw values in slot order
+	 * @access protected
+	 * @name SchemaVariantMap::$mSlots
+	 * @var HH\Vector<mixed>
+	 */
+	protected Vector<mixed> $mSlots   = Vector {};
+
+	//////////////////////////////////////////////////////////////////////////////
+	/// Constructor /////////////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////
+
+	/**
+	 * This method sets up a row with a schema and existing data, every column the data does not have is null
+	 * @access public
+	 * @name SchemaVariantMap::__construct()
+	 * @param VariantSchema $vscSchema
+	 * @param KeyedTraversable<string, mixed> $ktsSource [null]
+	 * @return void
+	 * @throws Exception
+	 */
+	public function __construct(VariantSchema $vscSchema, ?KeyedTraversable<string, mixed> $ktsSource = null) : void
+	{
+		// Set the schema into the instance
+		$this->mSchema = $vscSchema;
+		// Create the slots
+		$this->mSlots  = Vector {};
+		$this->mSlots->resize($vscSchema->count(), null);
+		// Check for data
+		if ($ktsSource !== null) {
+			// Iterate over the data
+			foreach ($ktsSource as $strKey => $mixValue) {
+				// Resolve the key
+				$intSlot = $this->slotOf((string) $strKey);
+				// Set the coerced value
+				$this->mSlots->set($intSlot, $vscSchema->coerce($intSlot, $mixValue));
+			}
+		}
+		// Iterate over the slots
+		foreach ($this->mSlots->getIterator() as $intSlot => $mixValue) {
+			// Check for a missing value the column cannot do without
+			if ($mixValue === null) {
+				// Let the schema check the column
+				$vscSchema->coerce($intSlot, null);
+			}
+		}
+	}
+
+	//////////////////////////////////////////////////////////////////////////////
+	/// Protected Methods ///////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////
+
+	/**
+	 * This method walks the columns in slot order with the values as they are stored in the slots
+	 * @access protected
+	 * @name SchemaVariantMap::entryIterator()
+	 * @return KeyedIterator<string, mixed>
+	 */
+	protected function entryIterator() : KeyedIterator<string, mixed>
+	{
+		// Iterate over the slots
+		for ($intSlot = 0; $intSlot < $this->mSchema->count(); ++$intSlot) {
+			// Yield the stored value, rows made before a column was added have no slot for it
+			yield $this->mSchema->getNameAt($intSlot) => $this->mSlots->get($intSlot);
+		}
+	}
+
+	/**
+	 * This method returns the slot of a key, unknown keys throw
+	 * @access protected
+	 * @name SchemaVariantMap::slotOf()
+	 * @param string $strKey
+	 * @return int
+	 * @throws Exception
+	 */
+	protected function slotOf(string $strKey) : int
+	{
+		// Resolve the key
+		$intSlot = $this->mSchema->slotOf($strKey);
+		// Make sure the schema has the key
+		if ($intSlot === null) {
+			// Throw an exception
+			throw new Exception('VariantSchema '.$this->mSchema->getName().' has no column named '.$strKey.'.');
+		}
+		// We're done
+		return $intSlot;
+	}
+
+	/**
+	 * This method returns a view of a slot with its declared type, changes made through it are written back into the row
+	 * @access protected
+	 * @name SchemaVariantMap::view()
+	 * @param int $intSlot
+	 * @return Variant
+	 */
+	protected function view(int $intSlot) : Variant
+	{
+		// Check for a row made before the column was added
+		if ($intSlot >= $this->mSlots->count()) {
+			// Grow the slots
+			$this->mSlots->resize($this->mSchema->count(), null);
+		}
+		// Grab the value
+		$mixValue = $this->mSlots->at($intSlot);
+		// Return the view, the slot keeps the raw value
+		return new SchemaVariant($this, $this->mSchema->getNameAt($intSlot), $mixValue, (($mixValue === null) ? Type::VNull : $this->mSchema->getTypeAt($intSlot)));
+	}
+
+	//////////////////////////////////////////////////////////////////////////////
+	/// Public Methods //////////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////
+
+	/**
+	 * This method returns the value of a column with case-insensitivity, Variant::Factory(null) if there is no such column
+	 * @access public
+	 * @name SchemaVariantMap::at()
+	 * @param string $strKey
+	 * @return Variant
+	 */
+	public function at(string $strKey) : Variant
+	{
+		// Resolve the key
+		$intSlot = $this->mSchema->slotOf($strKey);
+		// Return the view, or an empty variant
+		return (($intSlot === null) ? Variant::Factory(null) : $this->view($intSlot));
+	}
+
+	/**
+	 * This method sets every column to null, which throws if a column cannot be null
+	 * @access public
+	 * @name SchemaVariantMap::clear()
+	 * @return VariantMap $this
+	 * @throws Exception
+	 */
+	public function clear() : VariantMap
+	{
+		// Iterate over the slots
+		for ($intSlot = 0; $intSlot < $this->mSchema->count(); ++$intSlot) {
+			// Make sure the column can be null
+			$this->mSchema->coerce($intSlot, null);
+		}
+		// Reset the slots
+		$this->mSlots = Vector {};
+		$this->mSlots->resize($this->mSchema->count(), null);
+		// The data has changed
+		$this->invalidate();
+		// We're done
+		return $this;
+	}
+
+	/**
+	 * This method converts the row to a specified target type, the values live in the slots so the conversion runs over getData()
+	 * toJson() goes through here as well
+	 * @access public
+	 * @name SchemaVariantMap::convert()
+	 * @param Type $typeTarget
+	 * @return mixed
+	 */
+	public function convert(Type $typeTarget) : mixed
+	{
+		// Return the conversion of the row
+		return Variant::withType($this->getData(), Type::VMap)->convert($typeTarget);
+	}
+
+	/**
+	 * This method returns the number of columns
+	 * @access public
+	 * @name SchemaVariantMap::count()
+	 * @return int
+	 */
+	public function count() : int
+	{
+		// Return the column count
+		return $this->mSchema->count();
+	}
+
+	/**
+	 * This method returns an iterator over the columns in slot order
+	 * @access public
+	 * @name SchemaVariantMap::getIterator()
+	 * @return KeyedIterator<string, Variant>
+	 */
+	public function getIterator() : KeyedIterator<string, Variant>
+	{
+		// Iterate over the slots
+		for ($intSlot = 0; $intSlot < $this->mSchema->count(); ++$intSlot) {
+			// Yield the view
+			yield $this->mSchema->getNameAt($intSlot) => $this->view($intSlot);
+		}
+	}
+
+	/**
+	 * This method returns whether or not the schema has no columns
+	 * @access public
+	 * @name SchemaVariantMap::isEmpty()
+	 * @return bool
+	 */
+	public function isEmpty() : bool
+	{
+		// Return the empty status
+		return ($this->mSchema->count() === 0);
+	}
+
+	/**
+	 * This method sets a column to null, which throws if it cannot be null
+	 * @access public
+	 * @name SchemaVariantMap::remove()
+	 * @param string $strKey
+	 * @return VariantMap $this
+	 * @throws Exception
+	 */
+	public function remove(string $strKey) : VariantMap
+	{
+		// Null the column
+		return $this->set($strKey, null);
+	}
+
+	/**
+	 * This method searches the schema for a column with case-insensitivity, if one is found the actual column name is returned, null elsewise
+	 * @access public
+	 * @name SchemaVariantMap::search()
+	 * @param string $strKey
+	 * @return string
+	 */
+	public function search(string $strKey) : ?string
+	{
+		// Resolve the key
+		$intSlot = $this->mSchema->slotOf($strKey);
+		// Return the real name
+		return (($intSlot === null) ? null : $this->mSchema->getNameAt($intSlot));
+	}
+
+	/**
+	 * This method sets a column, the value is coerced to the declared type and unknown keys throw
+	 * @access public
+	 * @name SchemaVariantMap::set()
+	 * @param string $strKey
+	 * @param mixed $mixValue
+	 * @return VariantMap $this
+	 * @throws Exception
+	 */
+	public function set(string $strKey, mixed $mixValue) : VariantMap
+	{
+		// Resolve the key
+		$intSlot = $this->slotOf($strKey);
+		// Check for a row made before the column was added
+		if ($intSlot >= $this->mSlots->count()) {
+			// Grow the slots
+			$this->mSlots->resize($this->mSchema->count(), null);
+		}
+		// Set the coerced value
+		$this->mSlots->set($intSlot, $this->mSchema->coerce($intSlot, $mixValue));
+		// The data has changed
+		$this->invalidate();
+		// We're done
+		return $this;
+	}
+
+	/**
+	 * This method sets a column from a Variant, the raw value is coerced to the declared type and unknown keys throw
+	 * @access public
+	 * @name SchemaVariantMap::setVariant()
+	 * @param string $strKey
+	 * @param Variant $varValue
+	 * @return VariantMap $this
+	 * @throws Exception
+	 */
+	public function setVariant(string $strKey, Variant $varValue) : VariantMap
+	{
+		// Set the raw value
+		return $this->set($strKey, $varValue->getData());
+	}
+
+	//////////////////////////////////////////////////////////////////////////////
+	/// Converters //////////////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////
+
+	/**
+	 * This method returns the row as an associative array with the values as their declared type
+	 * @access public
+	 * @name SchemaVariantMap::toArray()
+	 * @return array<string, mixed>
+	 */
+	public function toArray() : array<string, mixed>
+	{
+		// Create the response array
+		$arrData = [];
+		// Iterate over the slots
+		for ($intSlot = 0; $intSlot < $this->mSchema->count(); ++$intSlot) {
+			// Set the raw value, rows made before a column was added have no slot for it
+			$arrData[$this->mSchema->getNameAt($intSlot)] = $this->mSlots->get($intSlot);
+		}
+		// We're done
+		return $arrData;
+	}
+
+	/**
+	 * This method returns the column names as an array
+	 * @access public
+	 * @name SchemaVariantMap::toKeysArray()
+	 * @return array<string>
+	 */
+	public function toKeysArray() : array<string>
+	{
+		// Return the names
+		return $this->mSchema->getNames()->toArray();
+	}
+
+	/**
+	 * This method returns the column names as a vector
+	 * @access public
+	 * @name SchemaVariantMap::toKeysVector()
+	 * @return HH\Vector<string>
+	 */
+	public function toKeysVector() : Vector<string>
+	{
+		// Return the names
+		return $this->mSchema->getNames()->toVector();
+	}
+
+	/**
+	 * This method returns the values as an array with the values as their declared type
+	 * @access public
+	 * @name SchemaVariantMap::toValuesArray()
+	 * @return array<mixed>
+	 */
+	public function toValuesArray() : array<mixed>
+	{
+		// Return the values
+		return array_values($this->toArray());
+	}
+
+	/**
+	 * This method returns the values as a vector with the values as their declared type
+	 * @access public
+	 * @name SchemaVariantMap::toValuesVector()
+	 * @return HH\Vector<mixed>
+	 */
+	public function toValuesVector() : Vector<mixed>
+	{
+		// Return the values
+		return new Vector($this->toValuesArray());
+	}
+
+	/**
+	 * This method returns the row as an array with the values in Variant form
+	 * @access public
+	 * @name SchemaVariantMap::toVariantArray()
+	 * @return array<string, Variant>
+	 */
+	public function toVariantArray() : array<string, Variant>
+	{
+		// Create the response array
+		$arrData = [];
+		// Iterate over the columns
+		foreach ($this->getIterator() as $strKey => $varValue) {
+			// Set the view
+			$arrData[$strKey] = $varValue;
+		}
+		// We're done
+		return $arrData;
+	}
+
+	/**
+	 * This method returns the values as an array of Variants
+	 * @access public
+	 * @name SchemaVariantMap::toVariantValuesArray()
+	 * @return array<Variant>
+	 */
+	public function toVariantValuesArray() : array<Variant>
+	{
+		// Return the views
+		return array_values($this->toVariantArray());
+	}
+
+	/**
+	 * This method returns the values as a vector of Variants
+	 * @access public
+	 * @name SchemaVariantMap::toVariantValuesVector()
+	 * @return HH\Vector<Variant>
+	 */
+	public function toVariantValuesVector() : Vector<Variant>
+	{
+		// Return the views
+		return new Vector($this->toVariantValuesArray());
+	}
+
+	//////////////////////////////////////////////////////////////////////////////
+	/// Getters /////////////////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////
+
+	/**
+	 * This method returns the row in its declared types
+	 * @access public
+	 * @name SchemaVariantMap::getData()
+	 * @return HH\Map<string, mixed>
+	 */
+	public function getData() : Map<string, mixed>
+	{
+		// Return the row
+		return new Map($this->toArray());
+	}
+
+	/**
+	 * This method returns the schema of the row
+	 * @access public
+	 * @name SchemaVariantMap::getSchema()
+	 * @return VariantSchema
+	 */
+	public function getSchema() : VariantSchema
+	{
+		// Return the schema
+		return $this->mSchema;
+	}
+
+	/**
+	 * This method returns the row itself, its values only live in the slots
+	 * @access public
+	 * @name SchemaVariantMap::getVariantData()
+	 * @return SchemaVariantMap $this
+	 */
+	public function getVariantData() : Variant
+	{
+		// Return the row
+		return $this;
+	}
+}
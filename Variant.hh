@@ -1,5 +1,10 @@
 <?hh
 
+/**
+ * Needed Libraries
+ */
+require_once('array_is_associative.hh');
+
 ///////////////////////////////////////////////////////////////////////////////
 /// Enumerations /////////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////////////////////////
@@ -50,7 +55,7 @@ class Variant
 	 * @name Variant::$mConversionMap
 	 * @var Map<Type, Vector<Type>>
 	 */
-	protected Map<Type, Vector<Type>> $mConversionMap = Map {
+	protected static Map<Type, Vector<Type>> $mConversionMap = Map {
 		Type::VArray    => Vector { Type::VJson, Type::VMap, Type::VNull, Type::VObject, Type::VPair, Type::VSet, Type::VVector },
 		Type::VBinary   => Vector { Type::VNull, Type::VString },
 		Type::VBoolean  => Vector { Type::VDouble, Type::VFloat, Type::VInteger, Type::VNull, Type::VString },
@@ -70,31 +75,71 @@ class Variant
 		Type::VVector   => Vector { Type::VArray, Type::VJson, Type::VMap, Type::VNull, Type::VSet }
 	};
 
+	/**
+	 * This property contains the conversion map compiled into one bitmask of target ordinals per source type
+	 * @access protected
+	 * @name Variant::$mConversionMatrix
+	 * @var HH\Map<Type, int>
+	 */
+	protected static ?Map<Type, int> $mConversionMatrix      = null;
+
+	/**
+	 * This property contains the typed converter for each source type, built the first time a conversion needs it
+	 * @access protected
+	 * @name Variant::$mConverters
+	 * @var HH\Map<Type, (function(Variant, Type): mixed)>
+	 */
+	protected static ?Map<Type, (function(Variant, Type): mixed)> $mConverters = null;
+
 	/**
 	 * This property contains the actual data for the class
 	 * @access protected
 	 * @name Variant::$mData
 	 * @var mixed
 	 */
-	protected mixed $mData                            = null;
+	protected mixed $mData                                   = null;
 
 	/**
 	 * This property contains the reserved instance types
 	 * @access protected
 	 * @name Variant::$mInstanceTypes
-	 * @var HH\Vector<Type>
+	 * @var HH\Set<Type>
 	 */
-	protected Vector<Type> $mInstanceTypes            = Vector {
+	protected static Set<Type> $mInstanceTypes               = Set {
 		Type::VMap, Type::VPair, Type::VSet, Type::VVector
 	};
 
+	/**
+	 * This property tells the instance whether or not it is shared through VariantPool and must be copied before it changes
+	 * @access protected
+	 * @name Variant::$mInterned
+	 * @var bool
+	 */
+	protected bool $mInterned                                = false;
+
+	/**
+	 * This property caches the data decoded as an associative array once it has been detected as JSON, null until then
+	 * @access protected
+	 * @name Variant::$mJson
+	 * @var array<string, mixed>
+	 */
+	protected ?array<string, mixed> $mJson                   = null;
+
+	/**
+	 * This property caches the data decoded as a stdClass once it has been converted to an object, null until then
+	 * @access protected
+	 * @name Variant::$mJsonObject
+	 * @var stdClass
+	 */
+	protected ?stdClass $mJsonObject                         = null;
+
 	/**
 	 * This map contains the true null type for each variant type
 	 * @access protected
 	 * @name Variant::$mNullTypes
 	 * @var Map<Type, mixed>
 	 */
-	protected Map<Type, mixed> $mNullTypes            = Map {
+	protected static Map<Type, mixed> $mNullTypes            = Map {
 		Type::VArray    => [],
 		Type::VBinary   => null,
 		Type::VBoolean  => false,
@@ -119,20 +164,73 @@ class Variant
 	 * @name Variant::$mNumericTypes
 	 * @var HH\Vector<Type>
 	 */
-	protected Vector<Type> $mNumericTypes             = Vector {
+	protected static Vector<Type> $mNumericTypes             = Vector {
 		Type::VDouble, Type::VFloat, Type::VInteger
 	};
 
+	/**
+	 * This property contains the stamp of the last change to the data, 0 until it changes
+	 * @access protected
+	 * @name Variant::$mRevision
+	 * @var int
+	 */
+	protected int $mRevision                                 = 0;
+
+	/**
+	 * This property counts the changes made to any instance, each change stamps its instance with the next count so stamps only ever grow
+	 * @access protected
+	 * @name Variant::$mRevisionCounter
+	 * @var int
+	 */
+	protected static int $mRevisionCounter                   = 0;
+
 	/**
 	 * This property contains all of the scalar types
 	 * @access protected
 	 * @name Variant::$mScalarTypes
 	 * @var HH\Vector<Type>
 	 */
-	protected Vector<Type> $mScalarTypes              = Vector {
+	protected static Vector<Type> $mScalarTypes              = Vector {
 		Type::VBoolean, Type::VDouble, Type::VFloat, Type::VInteger, Type::VString
 	};
 
+	/**
+	 * This property contains the ordinal of each type, in declaration order, used as its bit in the conversion matrix
+	 * @access protected
+	 * @name Variant::$mTypeOrdinals
+	 * @var HH\Map<Type, int>
+	 */
+	protected static Map<Type, int> $mTypeOrdinals           = Map {
+		Type::VArray    => 0,
+		Type::VBinary   => 1,
+		Type::VBoolean  => 2,
+		Type::VCallable => 3,
+		Type::VCustom   => 4,
+		Type::VDouble   => 5,
+		Type::VFloat    => 6,
+		Type::VInteger  => 7,
+		Type::VJson     => 8,
+		Type::VMap      => 9,
+		Type::VNull     => 10,
+		Type::VNumeric  => 11,
+		Type::VPair     => 12,
+		Type::VObject   => 13,
+		Type::VResource => 14,
+		Type::VSCalar   => 15,
+		Type::VSet      => 16,
+		Type::VString   => 17,
+		Type::VUnknown  => 18,
+		Type::VVector   => 19
+	};
+
+	/**
+	 * This property caches the resolved type of the data, null until it has been detected
+	 * @access protected
+	 * @name Variant::$mType
+	 * @var Type
+	 */
+	protected ?Type $mType                                   = null;
+
 	//////////////////////////////////////////////////////////////////////////////
 	/// Constructor /////////////////////////////////////////////////////////////
 	////////////////////////////////////////////////////////////////////////////
@@ -142,12 +240,15 @@ class Variant
 	 * @access public
 	 * @name Variant::Variant()
 	 * @param mixed $mixData [null]
+	 * @param bool $blnInterned [false]
 	 * @return void
 	 */
-	public function __construct(mixed $mixData = null) : void
+	public function __construct(mixed $mixData = null, bool $blnInterned = false) : void
 	{
 		// Set the data into the instance
-		$this->mData = $mixData;
+		$this->mData     = $mixData;
+		// Set the interned flag into the instance
+		$this->mInterned = $blnInterned;
 	}
 
 	//////////////////////////////////////////////////////////////////////////////
@@ -159,37 +260,247 @@ class Variant
 	 * @access public
 	 * @name Variant::Factory()
 	 * @param mixed $mixData [null]
+	 * @param bool $blnLazy [false]
 	 * @return Variant self
 	 * @static
 	 */
-	public static function Factory(mixed $mixData = null) : Variant
+	public static function Factory(mixed $mixData = null, bool $blnLazy = false) : Variant
 	{
 		// Make sure we have a scalar
 		if (is_scalar($mixData) || ($mixData === null)) {
-			// We're done
-			return new self($mixData);
-		} elseif (is_array($mixData) && boolval(count(array_filter(array_keys($mixData), 'is_string')))) {
-			// Return a new instance of VariantMap
-			return VariantMap::Factory($mixData);
+			// Create the instance, sharing the pooled one when interning is on
+			$varReturn = (VariantPool::enabled() ? VariantPool::intern($mixData) : new self($mixData));
+		} elseif (is_array($mixData) && array_is_associative($mixData)) {
+			// Create a new instance of VariantMap
+			$varReturn = VariantMap::Factory($mixData, $blnLazy);
 		} elseif (is_array($mixData)) {
-			// Return a new instance of VariantList
-			return VariantList::Factory($mixData);
-		} elseif ($mixData instanceof HH\Map) {
-			// Return a new instance of VariantMap
-			return VariantMap::Factory($mixData);
-		} elseif ($mixData instanceof HH\Vector) {
-			// Return a new instance of VariantList
-			return VariantList::Factory($mixData);
-		} elseif (is_object($mixData)) {
-			// Return a new instance of VariantMap
-			return VariantMap::Factory($mixData);
+			// Create a new instance of VariantList
+			$varReturn = VariantList::Factory($mixData, $blnLazy);
+		} elseif ($mixData instanceof HH\ConstMap) {
+			// Create a new instance of VariantMap
+			$varReturn = VariantMap::Factory($mixData, $blnLazy);
+		} elseif ($mixData instanceof HH\ConstVector) {
+			// Create a new instance of VariantList
+			$varReturn = VariantList::Factory($mixData, $blnLazy);
 		} elseif ($mixData instanceof Variant) {
-			// Re-run this Constructor
-			return self::Factory($mixData->getData());
+			// Re-run this Constructor, the immutable view is cached by VariantMap and VariantList
+			return self::Factory($mixData->getImmutableData(), $blnLazy);
+		} elseif (is_object($mixData)) {
+			// Create a new instance of VariantMap
+			$varReturn = VariantMap::Factory($mixData, $blnLazy);
 		} else {
 			// Throw an exception
 			throw new Exception('Unable to convert data to Variant, VariantList or VariantMap.');
 		}
+		// Check for counting
+		if (VariantStats::enabled()) {
+			// Count the instance by its class
+			VariantStats::increment('factory.'.get_class($varReturn));
+		}
+		// We're done
+		return $varReturn;
+	}
+
+	//////////////////////////////////////////////////////////////////////////////
+	/// Public Static Methods ///////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////
+
+	/**
+	 * This method determines whether or not a source type can be converted to a target type
+	 * @access public
+	 * @name Variant::canConvert()
+	 * @param Type $typeSource
+	 * @param Type $typeTarget
+	 * @return bool
+	 * @static
+	 */
+	public static function canConvert(Type $typeSource, Type $typeTarget) : bool
+	{
+		// Return the bit for the target from the source's row in the matrix
+		return (((self::conversionMatrix()->get($typeSource) ?? 0) & (1 << self::$mTypeOrdinals->at($typeTarget))) !== 0);
+	}
+
+	/**
+	 * This method decodes data produced by Variant::toBinary() back into a Variant tree
+	 * @access public
+	 * @name Variant::fromBinary()
+	 * @param string $strData
+	 * @param array<string> $arrAllowedClasses [[]] The classes VCustom payloads may hold objects of, others come back as __PHP_Incomplete_Class
+	 * @return Variant
+	 * @static
+	 * @see VariantBinary::decode()
+	 */
+	public static function fromBinary(string $strData, array<string> $arrAllowedClasses = []) : Variant
+	{
+		// Return the decoded tree
+		return VariantBinary::decode($strData, $arrAllowedClasses);
+	}
+
+	/**
+	 * This method returns the ordinal of a type, it is stable and used as the type's bit and tag
+	 * @access public
+	 * @name Variant::typeOrdinal()
+	 * @param Type $typeValue
+	 * @return int
+	 * @static
+	 */
+	public static function typeOrdinal(Type $typeValue) : int
+	{
+		// Return the ordinal
+		return self::$mTypeOrdinals->at($typeValue);
+	}
+
+	/**
+	 * This method wraps data whose type is already known, the type is preset so it is never detected
+	 * @access public
+	 * @name Variant::withType()
+	 * @param mixed $mixData
+	 * @param Type $typeData
+	 * @return Variant
+	 * @static
+	 */
+	public static function withType(mixed $mixData, Type $typeData) : Variant
+	{
+		// Create the instance
+		$varReturn        = new self($mixData);
+		// Preset the type
+		$varReturn->mType = $typeData;
+		// We're done
+		return $varReturn;
+	}
+
+	//////////////////////////////////////////////////////////////////////////////
+	/// Protected Static Methods ////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////
+
+	/**
+	 * This method compiles the conversion map into the conversion matrix the first time it is needed
+	 * @access protected
+	 * @name Variant::conversionMatrix()
+	 * @return HH\Map<Type, int>
+	 * @static
+	 */
+	protected static function conversionMatrix() : Map<Type, int>
+	{
+		// Check for a compiled matrix
+		if (self::$mConversionMatrix === null) {
+			// Create the matrix
+			$mapMatrix = Map {};
+			// Iterate over the source types
+			foreach (self::$mConversionMap->getIterator() as $typeSource => $vecTargets) {
+				// Start with no targets
+				$intTargets = 0;
+				// Iterate over the target types
+				foreach ($vecTargets->getIterator() as $typeTarget) {
+					// Set the bit for the target
+					$intTargets |= (1 << self::$mTypeOrdinals->at($typeTarget));
+				}
+				// Set the row into the matrix
+				$mapMatrix->set($typeSource, $intTargets);
+			}
+			// Cache the matrix
+			self::$mConversionMatrix = $mapMatrix;
+		}
+		// Return the matrix
+		return self::$mConversionMatrix;
+	}
+
+	/**
+	 * This method builds the table of typed converters the first time it is needed, one per source type in the conversion map
+	 * @access protected
+	 * @name Variant::converters()
+	 * @return HH\Map<Type, (function(Variant, Type): mixed)>
+	 * @static
+	 */
+	protected static function converters() : Map<Type, (function(Variant, Type): mixed)>
+	{
+		// Check for a built table
+		if (self::$mConverters === null) {
+			// Build the table
+			self::$mConverters = Map {
+				Type::VArray    => (Variant $varSource, Type $typeTarget) ==> $varSource->arrayTo($typeTarget),
+				Type::VBinary   => (Variant $varSource, Type $typeTarget) ==> $varSource->binaryTo($typeTarget),
+				Type::VBoolean  => (Variant $varSource, Type $typeTarget) ==> $varSource->booleanTo($typeTarget),
+				Type::VCallable => (Variant $varSource, Type $typeTarget) ==> $varSource->callableTo($typeTarget),
+				Type::VDouble   => (Variant $varSource, Type $typeTarget) ==> $varSource->doubleTo($typeTarget),
+				Type::VFloat    => (Variant $varSource, Type $typeTarget) ==> $varSource->floatTo($typeTarget),
+				Type::VInteger  => (Variant $varSource, Type $typeTarget) ==> $varSource->integerTo($typeTarget),
+				Type::VJson     => (Variant $varSource, Type $typeTarget) ==> $varSource->jsonTo($typeTarget),
+				Type::VMap      => (Variant $varSource, Type $typeTarget) ==> $varSource->mapTo($typeTarget),
+				Type::VNull     => (Variant $varSource, Type $typeTarget) ==> $varSource->nullTo($typeTarget),
+				Type::VPair     => (Variant $varSource, Type $typeTarget) ==> $varSource->pairTo($typeTarget),
+				Type::VObject   => (Variant $varSource, Type $typeTarget) ==> $varSource->objectTo($typeTarget),
+				Type::VResource => (Variant $varSource, Type $typeTarget) ==> $varSource->resourceTo($typeTarget),
+				Type::VSet      => (Variant $varSource, Type $typeTarget) ==> $varSource->setTo($typeTarget),
+				Type::VString   => (Variant $varSource, Type $typeTarget) ==> $varSource->stringTo($typeTarget),
+				Type::VUnknown  => (Variant $varSource, Type $typeTarget) ==> $varSource->unknownTo($typeTarget),
+				Type::VVector   => (Variant $varSource, Type $typeTarget) ==> $varSource->vectorTo($typeTarget)
+			};
+		}
+		// Return the table
+		return self::$mConverters;
+	}
+
+	/**
+	 * This method builds a hash key for raw data, values only share a key when they are identical in type and value
+	 * @access protected
+	 * @name Variant::hashKey()
+	 * @param mixed $mixData
+	 * @return string
+	 * @static
+	 */
+	protected static function hashKey(mixed $mixData) : string
+	{
+		// Check the type, scalars are tagged and used as-is
+		if (is_string($mixData)) {
+			// Return the string key
+			return 's'.$mixData;
+		} elseif (is_int($mixData)) {
+			// Return the integer key
+			return 'i'.$mixData;
+		} elseif ($mixData === null) {
+			// Return the null key
+			return 'n';
+		} elseif (is_bool($mixData)) {
+			// Return the boolean key
+			return ($mixData ? 'b1' : 'b0');
+		} elseif (is_float($mixData)) {
+			// Return the float key from its exact bytes
+			return 'd'.pack('d', $mixData);
+		} elseif ($mixData instanceof Variant) {
+			// Hash the data, the instance state around it does not matter
+			return self::hashKey($mixData->getData());
+		}
+		// Nested values are hashed by their structure
+		return 'x'.serialize($mixData);
+	}
+
+	/**
+	 * This method checks whether or not a string can be a JSON object, the first and last non-blank bytes must be braces
+	 * @access protected
+	 * @name Variant::looksLikeJson()
+	 * @param string $strData
+	 * @return bool
+	 * @static
+	 */
+	protected static function looksLikeJson(string $strData) : bool
+	{
+		// Skip the leading whitespace
+		$intStart = strspn($strData, " \t\n\r");
+		// Check the first byte
+		if (($intStart === strlen($strData)) || ($strData[$intStart] !== '{')) {
+			// We're done
+			return false;
+		}
+		// Localize the last byte
+		$intEnd = (strlen($strData) - 1);
+		// Skip the trailing whitespace
+		while (($intEnd > $intStart) && (strpos(" \t\n\r", $strData[$intEnd]) !== false)) {
+			// Move back a byte
+			--$intEnd;
+		}
+		// Check the last byte
+		return (($intEnd > $intStart) && ($strData[$intEnd] === '}'));
 	}
 
 	//////////////////////////////////////////////////////////////////////////////
@@ -340,6 +651,69 @@ class Variant
 		}
 	}
 
+	/**
+	 * This method returns the data decoded as an associative array, the decode is kept until the data changes
+	 * @access protected
+	 * @name Variant::jsonArray()
+	 * @return array<string, mixed>
+	 */
+	protected function jsonArray() : ?array<string, mixed>
+	{
+		// Check for a cached decode
+		if ($this->mJson !== null) {
+			// Check for counting
+			if (VariantStats::enabled()) {
+				// Count the decode we saved
+				VariantStats::increment('json_decode.avoided');
+			}
+			// We're done
+			return $this->mJson;
+		}
+		// Check for counting
+		if (VariantStats::enabled()) {
+			// Count the decode
+			VariantStats::increment('json_decode');
+		}
+		// Decode the data
+		$mixJson = json_decode($this->mData, true);
+		// Keep the decode if it is an object
+		$this->mJson = (is_array($mixJson) ? $mixJson : null);
+		// We're done
+		return $this->mJson;
+	}
+
+	/**
+	 * This method returns the data decoded as a stdClass, the decode is kept until the data changes, so the object is shared and must not be changed
+	 * An associative decode cannot tell an object from an array, so the object form is decoded once on its own instead of being built from it
+	 * @access protected
+	 * @name Variant::jsonObject()
+	 * @return stdClass
+	 */
+	protected function jsonObject() : ?stdClass
+	{
+		// Check for a cached decode
+		if ($this->mJsonObject !== null) {
+			// Check for counting
+			if (VariantStats::enabled()) {
+				// Count the decode we saved
+				VariantStats::increment('json_decode.avoided');
+			}
+			// We're done
+			return $this->mJsonObject;
+		}
+		// Check for counting
+		if (VariantStats::enabled()) {
+			// Count the decode
+			VariantStats::increment('json_decode');
+		}
+		// Decode the data
+		$mixJson = json_decode($this->mData);
+		// Keep the decode if it is an object
+		$this->mJsonObject = (($mixJson instanceof stdClass) ? $mixJson : null);
+		// We're done
+		return $this->mJsonObject;
+	}
+
 	/**
 	 * This method converts a json string to the target type
 	 * @access protected
@@ -351,13 +725,13 @@ class Variant
 	{
 		// Determine the target type
 		switch ($typeTarget) {
-			case Type::VArray  : return json_decode($this->mData, true);             break; // array
-			case Type::VMap    : return new Map(json_decode($this->mData,    true)); break; // HH\Map
-			case Type::VNull   : return null;                                        break; // null
-			case Type::VObject : return json_decode($this->mData);                   break; // stdClass
-			case Type::VPair   : return new Pair(json_decode($this->mData,   true)); break; // HH\Pair
-			case Type::VSet    : return new Set(json_decode($this->mData,    true)); break; // HH\Set
-			case Type::VVector : return new Vector(json_decode($this->mData, true)); break; // HH\Vector
+			case Type::VArray  : return $this->jsonArray();             break; // array
+			case Type::VMap    : return new Map($this->jsonArray());    break; // HH\Map
+			case Type::VNull   : return null;                           break; // null
+			case Type::VObject : return $this->jsonObject();            break; // stdClass
+			case Type::VPair   : return new Pair($this->jsonArray());   break; // HH\Pair
+			case Type::VSet    : return new Set($this->jsonArray());    break; // HH\Set
+			case Type::VVector : return new Vector($this->jsonArray()); break; // HH\Vector
 		}
 	}
 
@@ -521,6 +895,92 @@ class Variant
 		}
 	}
 
+	/**
+	 * This method drops everything derived from the data, it must be called whenever the data changes
+	 * @access protected
+	 * @name Variant::invalidate()
+	 * @return void
+	 */
+	protected function invalidate() : void
+	{
+		// Reset the type and the decoded JSON
+		$this->mType       = null;
+		$this->mJson       = null;
+		$this->mJsonObject = null;
+		// Stamp the change, containers compare it against the stamp of their cached views
+		$this->mRevision   = ++self::$mRevisionCounter;
+	}
+
+	/**
+	 * This method returns the newest change stamp of this instance and everything below it, a plain Variant has nothing below it
+	 * @access protected
+	 * @name Variant::revision()
+	 * @return int
+	 */
+	protected function revision() : int
+	{
+		// Return the stamp
+		return $this->mRevision;
+	}
+
+	/**
+	 * This method returns an instance that is safe to change in place, a private copy for an interned instance and this instance elsewise
+	 * @access protected
+	 * @name Variant::unshare()
+	 * @return Variant
+	 */
+	protected function unshare() : Variant
+	{
+		// Check for a shared instance
+		if ($this->mInterned) {
+			// Return a private copy of the data
+			return new self($this->mData);
+		}
+		// We're done
+		return $this;
+	}
+
+	/**
+	 * This method detects the actual type of the data
+	 * @access protected
+	 * @name Variant::detectType()
+	 * @return Type
+	 */
+	protected function detectType() : Type
+	{
+		// Get the type
+		$strType = gettype($this->mData);
+		// Check for an object
+		if ($strType === Type::VObject) {
+			// Grab the class name
+			$strClass = get_class($this->mData);
+			// Check for one of the reserved instance types
+			if (self::$mInstanceTypes->contains($strClass)) {
+				// Return the actual type
+				return Type::assert($strClass);
+			}
+			// Return the object type
+			return Type::VObject;
+		/* } elseif (is_callable($this->mData)) {
+			// Return the actual type
+			return Type::VCallable; */
+		} elseif ($strType === Type::VString) {
+			// Check for a string that cannot be a JSON object
+			if (self::looksLikeJson($this->mData) === false) {
+				// Check for counting
+				if (VariantStats::enabled()) {
+					// Count the decode we saved
+					VariantStats::increment('json_decode.avoided');
+				}
+			} elseif ($this->jsonArray() !== null) {
+				// Return the actual type, the decode is kept for the conversion
+				return Type::VJson;
+			}
+		}
+		// Return the type
+		return Type::coerce($strType) ?? Type::VUnknown;
+	}
+
 	//////////////////////////////////////////////////////////////////////////////
 	/// Public Methods //////////////////////////////////////////////////////////
 	////////////////////////////////////////////////////////////////////////////
@@ -534,13 +994,8 @@ class Variant
 	 */
 	public function can(Type $typeTarget) : bool
 	{
-		// Check the type
-		if ($this->mConversionMap->get($this->getType())->linearSearch($typeTarget) !== -1) {
-			// A conversion is possible
-			return true;
-		}
-		// No conversion possible at this time
-		return false;
+		// Return the matrix lookup
+		return self::canConvert($this->getType(), $typeTarget);
 	}
 
 	/**
@@ -576,36 +1031,29 @@ class Variant
 	 */
 	public function convert(Type $typeTarget) : mixed
 	{
+		// Localize the source type
+		$typeSource = $this->getType();
+		// Check for counting
+		if (VariantStats::enabled()) {
+			// Count the conversion by its pair of types
+			VariantStats::increment('convert.'.$typeSource.'>'.$typeTarget);
+		}
 		// Check the type
-		if ($this->getType() === $typeTarget) {
+		if ($typeSource === $typeTarget) {
 			// Return the data
 			return $this->mData;
 		}
-		// Check to see if we can convert
-		if ($this->can($typeTarget)) {
-			// Determine the source type
-			switch ($this->getType()) {
-				case Type::VArray    : return $this->arrayTo($typeTarget);    break; // array
-				case Type::VBinary   : return $this->binaryTo($typeTarget);   break; // binary
-				case Type::VBoolean  : return $this->booleanTo($typeTarget);  break; // boolean
-				case Type::VCallable : return $this->callableTo($typeTarget); break; // callable
-				case Type::VDouble   : return $this->doubleTo($typeTarget);   break; // double
-				case Type::VFloat    : return $this->floatTo($typeTarget);    break; // float
-				case Type::VInteger  : return $this->integerTo($typeTarget);  break; // integer
-				case Type::VJson     : return $this->jsonTo($typeTarget);     break; // json
-				case Type::VMap      : return $this->mapTo($typeTarget);      break; // HH\Map
-				case Type::VNull     : return $this->nullTo($typeTarget);     break; // null
-				case Type::VPair     : return $this->pairTo($typeTarget);     break; // HH\Pair
-				case Type::VObject   : return $this->objectTo($typeTarget);   break; // stdClass
-				case Type::VResource : return $this->resourceTo($typeTarget); break; // resource
-				case Type::VSet      : return $this->setTo($typeTarget);      break; // HH\Set
-				case Type::VString   : return $this->stringTo($typeTarget);   break; // string
-				case Type::VUnknown  : return $this->unknownTo($typeTarget);  break; // unknown type
-				case Type::VVector   : return $this->vectorTo($typeTarget);   break; // HH\Vector
-			}
+		// Check to see if we can convert, every source type the matrix allows has a converter
+		if (self::canConvert($typeSource, $typeTarget)) {
+			// Look the converter up for the source type
+			$fnConverter = self::converters()->at($typeSource);
+			// Run the converter
+			return $fnConverter($this, $typeTarget);
 		} else {
-			// We cannot convert to this type, we're done
-			return $this->mNullTypes->get($typeTarget);
+			// Grab the null type for the target
+			$mixNull = self::$mNullTypes->get($typeTarget);
+			// The table is shared by every instance, so never hand out its collections
+			return (is_object($mixNull) ? clone $mixNull : $mixNull);
 		}
 	}
 
@@ -618,7 +1066,7 @@ class Variant
 	public function isEmpty() : bool
 	{
 		// Check the type
-		if ($this->mInstanceTypes->linearSearch($this->getType()) !== -1) {
+		if (self::$mInstanceTypes->contains($this->getType())) {
 			// We're done
 			return $this->mData->isEmpty();
 		}
@@ -635,7 +1083,7 @@ class Variant
 	public function isNull() : bool
 	{
 		// Check the type
-		if ($this->mInstanceTypes->linearSearch($this->getType()) !== -1) {
+		if (self::$mInstanceTypes->contains($this->getType())) {
 			// We're done
 			return $this->mData->isEmpty();
 		}
@@ -658,15 +1106,22 @@ class Variant
 
 	/**
 	 * This method replaces targets in the data in the instance in place, this changes the instance data
+	 * An interned instance is shared through VariantPool, so it is copied first and the changed copy is returned, values reached through
+	 * VariantMap::at() and VariantList::at() are never interned, so those are always changed in place
 	 * @access public
 	 * @name Variant::replace()
 	 * @param string $mixTarget
 	 * @param string $mixReplacement
 	 * @param bool $blnCaseSensitive [false]
-	 * @return Variant $this
+	 * @return Variant $this or its private copy
 	 */
 	public function replace(string $strTarget, string $strReplacement, bool $blnCaseSensitive = false) : Variant
 	{
+		// Check for a shared instance
+		if ($this->mInterned) {
+			// Change a private copy, the shared instance stays as-is
+			return $this->unshare()->replace($strTarget, $strReplacement, $blnCaseSensitive);
+		}
 		// Make sure we can convert
 		if ($this->can(Type::VString)) {
 			// Check for case sensitivity
@@ -677,6 +1132,8 @@ class Variant
 				// Reset the data
 				$this->mData = str_ireplace($strTarget, $strReplacement, $this->convert(Type::VString));
 			}
+			// The data has changed, drop anything derived from it
+			$this->invalidate();
 		}
 		// We're done
 		return $this;
@@ -708,6 +1165,28 @@ class Variant
 		return $strData;
 	}
 
+	/**
+	 * This method streams the data as JSON to a writable stream or a callable that takes each chunk
+	 * @access public
+	 * @name Variant::writeJson()
+	 * @param resource|callable $mixSink
+	 * @param int $intChunkSize [65536]
+	 * @return int The number of bytes written
+	 * @see VariantJsonWriter
+	 */
+	public function writeJson(mixed $mixSink, int $intChunkSize = 65536) : int
+	{
+		// Write the tree
+		$intBytes = VariantJsonWriter::Factory($mixSink, $intChunkSize)->write($this);
+		// Check for counting
+		if (VariantStats::enabled()) {
+			// Count the bytes
+			VariantStats::increment('bytes.json', $intBytes);
+		}
+		// Return the bytes written
+		return $intBytes;
+	}
+
 	//////////////////////////////////////////////////////////////////////////////
 	/// Converters //////////////////////////////////////////////////////////////
 	////////////////////////////////////////////////////////////////////////////
@@ -724,6 +1203,19 @@ class Variant
 		return $this->convert(Type::VArray);
 	}
 
+	/**
+	 * This method encodes the data, and everything below it, into the compact Variant binary format
+	 * @access public
+	 * @name Variant::toBinary()
+	 * @return string
+	 * @see VariantBinary::encode()
+	 */
+	public function toBinary() : string
+	{
+		// Return the encoded tree
+		return VariantBinary::encode($this);
+	}
+
 	/**
 	 * This method converts the data to a boolean
 	 * @access public
@@ -780,8 +1272,15 @@ class Variant
 	 */
 	public function toJson() : string
 	{
+		// Convert the data
+		$strJson = $this->convert(Type::VJson);
+		// Check for counting
+		if (VariantStats::enabled()) {
+			// Count the bytes
+			VariantStats::increment('bytes.json', strlen($strJson));
+		}
 		// Return the json conversion
-		return $this->convert(Type::VJson);
+		return $strJson;
 	}
 
 	/**
@@ -824,26 +1323,29 @@ class Variant
 	 */
 	public function toMySqlStringList(string $strDelimiter = ',') : string
 	{
-		// Check for an array
-		if (is_array($this->mData)) {
-			// Create the vector
-			$vecData = new Vector($this->mData);
-		} else {
-			// Create the vector
-			$vecData = $this->mData;
-		}
 		// Check the type
-		if ($vecData instanceof HH\Vector) {
-			// Create a temporary vector
-			$vecTemp = Vector {};
+		if (is_array($this->mData) || ($this->mData instanceof HH\ConstVector)) {
+			// Create the buffer
+			$strBuffer = '';
+			// Create the separator, empty for the first element
+			$strSeparator = '';
 			// Iterate over the data
-			foreach ($vecData->getIterator() as $mixData) {
-				// Set the data into the temporary vector
-				$vecTemp
-					->add(Variant::Factory($mixData)->toMySqlString());
+			foreach ($this->mData as $mixData) {
+				// Append the separator
+				$strBuffer .= $strSeparator;
+				// Check for a number or boolean, which never needs escaping
+				if (is_int($mixData) || is_float($mixData) || is_bool($mixData)) {
+					// Append the quoted data
+					$strBuffer .= "'".((string) $mixData)."'";
+				} else {
+					// Append the escaped data
+					$strBuffer .= Variant::Factory($mixData)->toMySqlString();
+				}
+				// Reset the separator
+				$strSeparator = $strDelimiter;
 			}
 			// Return the string list
-			return implode($strDelimiter, $vecTemp->toArray());
+			return $strBuffer;
 		}
 		// Return a MySQL null
 		return 'NULL';
@@ -918,26 +1420,29 @@ class Variant
 	 */
 	public function toStringList(string $strDelimiter = ',') : string
 	{
-		// Check for an array
-		if (is_array($this->mData)) {
-			// Set the data
-			$vecData = new Vector($this->mData);
-		} else {
-			// Set the data
-			$vecData = $this->mData;
-		}
 		// Check the type
-		if ($vecData instanceof HH\Vector) {
-			// Create a temporary vector
-			$vecTemp = Vector {};
+		if (is_array($this->mData) || ($this->mData instanceof HH\ConstVector)) {
+			// Create the buffer
+			$strBuffer = '';
+			// Create the separator, empty for the first element
+			$strSeparator = '';
 			// Iterate over the data
-			foreach ($vecData->getIterator() as $mixData) {
-				// Set the string into the vector
-				$vecTemp
-					->add(Variant::Factory($mixData)->toString());
+			foreach ($this->mData as $mixData) {
+				// Append the separator
+				$strBuffer .= $strSeparator;
+				// Check for a number or boolean, which converts directly
+				if (is_int($mixData) || is_float($mixData) || is_bool($mixData)) {
+					// Append the data
+					$strBuffer .= (string) $mixData;
+				} else {
+					// Append the converted data
+					$strBuffer .= Variant::Factory($mixData)->toString();
+				}
+				// Reset the separator
+				$strSeparator = $strDelimiter;
 			}
 			// Return the string list
-			return implode($strDelimiter, $vecTemp->toArray());
+			return $strBuffer;
 		}
 		// Return an empty string
 		return '';
@@ -1004,30 +1509,43 @@ class Variant
 		return $this->mData;
 	}
 
+	/**
+	 * This method returns the data in a form that cannot change, VariantMap and VariantList return a cached immutable view
+	 * @access public
+	 * @name Variant::getImmutableData()
+	 * @return mixed Variant::$mData
+	 */
+	public function getImmutableData() : mixed
+	{
+		// Scalars are values, so return the data as-is
+		return $this->mData;
+	}
+
 	/**
 	 * This method returns the actual type of the data
 	 * @access public
 	 * @name Variant::getType()
 	 * @return Type
 	 */
-	public function getType() : ?Type
+	public function getType() : Type
 	{
-		// Get the type
-		$strType = gettype($this->mData);
-		// Check for an object
-		if (($strType === Type::VObject) && ($this->mInstanceTypes->linearSearch($strType) == -1)) {
-			// Return the actual type
-			return $this->mInstanceTypes->get($this->mInstanceTypes->linearSearch($strType));
-		/* } elseif (is_callable($this->mData)) {
-			// Return the actual type
-			return Type::VCallable; */
-		} elseif (is_object(json_decode($this->mData))) {
-			// Return the actual type
-			return Type::VJson;
-		} else {
-			// Return the type
-			return $strType;
+		// Check for counting
+		if (VariantStats::enabled()) {
+			// Count the call
+			VariantStats::increment('getType');
+			// Check for a type that has to be detected
+			if ($this->mType === null) {
+				// Count the detection
+				VariantStats::increment('getType.detect');
+			}
+		}
+		// Check for a cached type
+		if ($this->mType === null) {
+			// Detect and cache the type
+			$this->mType = $this->detectType();
 		}
+		// Return the type
+		return $this->mType;
 	}
 
 	/**
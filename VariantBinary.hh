@@ -0,0 +1,395 @@
+<?hh
+
+///////////////////////////////////////////////////////////////////////////////
+/// VariantBinary Class Definition ///////////////////////////////////////////
+/////////////////////////////////////////////////////////////////////////////
+
+/**
+ * The format is a header followed by one node, each node starts with the ordinal of its Type as one byte:
+ *   VNull                     no payload
+ *   VBoolean                  one byte, 0 or 1
+ *   VInteger                  zigzag varint
+ *   VDouble                   8 byte IEEE 754 double in machine byte order
+ *   VString                   varint length and the bytes
+ *   VMap                      varint count and count pairs of a key node (VInteger or VString) and a value node
+ *   VVector                   varint count and count value nodes
+ *   VCustom                   varint length and the serialize()d data, for anything else
+ * VCustom payloads are only unserialized into objects of the classes the caller allows when decoding, so untrusted data cannot instantiate others
+ */
+class VariantBinary
+{
+	//////////////////////////////////////////////////////////////////////////////
+	/// Constants ///////////////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////
+
+	/**
+	 * This constant contains the header every encoding starts with, the last byte is the format version
+	 * @name VariantBinary::Header
+	 * @var string
+	 */
+	const string Header = "HVB\x01";
+
+	//////////////////////////////////////////////////////////////////////////////
+	/// Properties //////////////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////
+
+	/**
+	 * This property contains the tag byte for each type the format writes
+	 * @access protected
+	 * @name VariantBinary::$mTags
+	 * @var HH\Map<Type, string>
+	 */
+	protected static ?Map<Type, string> $mTags  = null;
+
+	/**
+	 * This property contains the type for each tag byte the format reads
+	 * @access protected
+	 * @name VariantBinary::$mTypes
+	 * @var HH\Map<string, Type>
+	 */
+	protected static ?Map<string, Type> $mTypes = null;
+
+	//////////////////////////////////////////////////////////////////////////////
+	/// Protected Static Methods ////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////
+
+	/**
+	 * This method builds the tag tables from the Type ordinals the first time they are needed
+	 * @access protected
+	 * @name VariantBinary::tags()
+	 * @return HH\Map<Type, string>
+	 * @static
+	 */
+	protected static function tags() : Map<Type, string>
+	{
+		// Check for the tables
+		if (self::$mTags === null) {
+			// Create the tables
+			self::$mTags  = Map {};
+			self::$mTypes = Map {};
+			// Iterate over the types
+			foreach (Type::getValues() as $typeValue) {
+				// Localize the tag
+				$strTag = chr(Variant::typeOrdinal($typeValue));
+				// Set the tag into the tables
+				self::$mTags->set($typeValue, $strTag);
+				self::$mTypes->set($strTag, $typeValue);
+			}
+		}
+		// Return the tags
+		return self::$mTags;
+	}
+
+	/**
+	 * This method encodes a raw key
+	 * @access protected
+	 * @name VariantBinary::encodeKey()
+	 * @param arraykey $mixKey
+	 * @return string
+	 * @static
+	 */
+	protected static function encodeKey(arraykey $mixKey) : string
+	{
+		// Check for an integer key
+		if (is_int($mixKey)) {
+			// Return the integer node
+			return self::$mTags->at(Type::VInteger).self::encodeVarint(($mixKey << 1) ^ ($mixKey >> 63));
+		}
+		// Return the string node
+		return self::$mTags->at(Type::VString).self::encodeVarint(strlen($mixKey)).$mixKey;
+	}
+
+	/**
+	 * This method encodes a Variant and everything below it
+	 * @access protected
+	 * @name VariantBinary::encodeNode()
+	 * @param Variant $varValue
+	 * @return string
+	 * @static
+	 */
+	protected static function encodeNode(Variant $varValue) : string
+	{
+		// Check for a map
+		if ($varValue instanceof VariantMap) {
+			// Start the node
+			$strNode = self::$mTags->at(Type::VMap).self::encodeVarint($varValue->count());
+			// Iterate over the map
+			foreach ($varValue->getIterator() as $mixKey => $varChild) {
+				// Append the key and the value
+				$strNode .= self::encodeKey($mixKey).self::encodeNode($varChild);
+			}
+			// We're done
+			return $strNode;
+		} elseif ($varValue instanceof VariantList) {
+			// Start the node
+			$strNode = self::$mTags->at(Type::VVector).self::encodeVarint($varValue->count());
+			// Iterate over the list
+			foreach ($varValue->getIterator() as $varChild) {
+				// Append the value
+				$strNode .= self::encodeNode($varChild);
+			}
+			// We're done
+			return $strNode;
+		}
+		// Localize the raw value, scalars are told apart without Variant::getType() so strings are never JSON-decoded
+		$mixValue = $varValue->getData();
+		// Check the raw type
+		if ($mixValue === null) {
+			// Return the null node
+			return self::$mTags->at(Type::VNull);
+		} elseif (is_bool($mixValue)) {
+			// Return the boolean node
+			return self::$mTags->at(Type::VBoolean).($mixValue ? "\x01" : "\x00");
+		} elseif (is_int($mixValue)) {
+			// Return the integer node
+			return self::$mTags->at(Type::VInteger).self::encodeVarint(($mixValue << 1) ^ ($mixValue >> 63));
+		} elseif (is_float($mixValue)) {
+			// Return the double node
+			return self::$mTags->at(Type::VDouble).pack('d', $mixValue);
+		} elseif (is_string($mixValue)) {
+			// Return the string node
+			return self::$mTags->at(Type::VString).self::encodeVarint(strlen($mixValue)).$mixValue;
+		}
+		// Serialize anything else
+		$strData = serialize($mixValue);
+		// Return the custom node
+		return self::$mTags->at(Type::VCustom).self::encodeVarint(strlen($strData)).$strData;
+	}
+
+	/**
+	 * This method encodes an unsigned 64-bit integer as a varint
+	 * @access protected
+	 * @name VariantBinary::encodeVarint()
+	 * @param int $intValue
+	 * @return string
+	 * @static
+	 */
+	protected static function encodeVarint(int $intValue) : string
+	{
+		// Create the output
+		$strVarint = '';
+		// Iterate over the 7-bit groups, lowest first
+		do {
+			// Grab the group
+			$intByte  = ($intValue & 0x7F);
+			// Shift the group out, without dragging the sign bit along
+			$intValue = (($intValue >> 7) & 0x01FFFFFFFFFFFFFF);
+			// Append the group, flagging that more follow
+			$strVarint .= chr(($intValue === 0) ? $intByte : ($intByte | 0x80));
+		} while ($intValue !== 0);
+		// We're done
+		return $strVarint;
+	}
+
+	/**
+	 * This method decodes a node and everything below it
+	 * @access protected
+	 * @name VariantBinary::decodeNode()
+	 * @param string $strData
+	 * @param int $intOffset The position to read from, moved past the node
+	 * @param array<string> $arrAllowedClasses
+	 * @return Variant
+	 * @static
+	 * @throws Exception
+	 */
+	protected static function decodeNode(string $strData, int &$intOffset, array<string> $arrAllowedClasses) : Variant
+	{
+		// Return the Variant for the raw value or container
+		return self::decodeValue($strData, $intOffset, true, $arrAllowedClasses);
+	}
+
+	/**
+	 * This method decodes a node, scalars are returned raw unless $blnWrap is set, containers are always returned as Variants
+	 * @access protected
+	 * @name VariantBinary::decodeValue()
+	 * @param string $strData
+	 * @param int $intOffset The position to read from, moved past the node
+	 * @param bool $blnWrap
+	 * @param array<string> $arrAllowedClasses
+	 * @return mixed
+	 * @static
+	 * @throws Exception
+	 */
+	protected static function decodeValue(string $strData, int &$intOffset, bool $blnWrap, array<string> $arrAllowedClasses) : mixed
+	{
+		// Make sure there is a tag
+		if ($intOffset >= strlen($strData)) {
+			// Throw an exception
+			throw new Exception('Truncated Variant binary data.');
+		}
+		// Grab the type
+		$typeNode = self::$mTypes->get($strData[$intOffset++]);
+		// Determine the type
+		switch ($typeNode) {
+			case Type::VNull    : // null
+				$mixValue = null;
+				break;
+			case Type::VBoolean : // boolean
+				$mixValue = ($strData[$intOffset++] === "\x01");
+				break;
+			case Type::VInteger : // integer
+				$intValue = self::decodeVarint($strData, $intOffset);
+				$mixValue = ((($intValue >> 1) & PHP_INT_MAX) ^ (-($intValue & 1)));
+				break;
+			case Type::VDouble  : // double
+				$mixValue   = unpack('d', substr($strData, $intOffset, 8))[1];
+				$intOffset += 8;
+				break;
+			case Type::VString  : // string
+				$intLength  = self::decodeVarint($strData, $intOffset);
+				$mixValue   = (string) substr($strData, $intOffset, $intLength);
+				$intOffset += $intLength;
+				break;
+			case Type::VCustom  : // serialized
+				$intLength  = self::decodeVarint($strData, $intOffset);
+				$mixValue   = unserialize(substr($strData, $intOffset, $intLength), ['allowed_classes' => ($arrAllowedClasses ?: false)]);
+				$intOffset += $intLength;
+				break;
+			case Type::VMap     : // VariantMap
+				$intCount = self::decodeVarint($strData, $intOffset);
+				$varMap   = new VariantMap();
+				// Iterate over the entries
+				for ($intEntry = 0; $intEntry < $intCount; ++$intEntry) {
+					// Read the key
+					$mixKey = self::decodeValue($strData, $intOffset, false, $arrAllowedClasses);
+					// Read the value
+					$varMap->setVariant($mixKey, self::decodeNode($strData, $intOffset, $arrAllowedClasses));
+				}
+				// We're done
+				return $varMap;
+			case Type::VVector  : // VariantList
+				$intCount = self::decodeVarint($strData, $intOffset);
+				$varList  = new VariantList();
+				// Reserve the indices
+				$varList->reserve($intCount);
+				// Iterate over the elements
+				for ($intEntry = 0; $intEntry < $intCount; ++$intEntry) {
+					// Read the value
+					$varList->addVariant(self::decodeNode($strData, $intOffset, $arrAllowedClasses));
+				}
+				// We're done
+				return $varList;
+			default             : // unknown
+				throw new Exception('Unknown Variant binary tag at byte '.($intOffset - 1).'.');
+		}
+		// Make sure the node was complete
+		if ($intOffset > strlen($strData)) {
+			// Throw an exception
+			throw new Exception('Truncated Variant binary data.');
+		}
+		// We're done
+		return ($blnWrap ? Variant::Factory($mixValue) : $mixValue);
+	}
+
+	/**
+	 * This method decodes an unsigned 64-bit varint
+	 * @access protected
+	 * @name VariantBinary::decodeVarint()
+	 * @param string $strData
+	 * @param int $intOffset The position to read from, moved past the varint
+	 * @return int
+	 * @static
+	 * @throws Exception
+	 */
+	protected static function decodeVarint(string $strData, int &$intOffset) : int
+	{
+		// Localize the value, the shift and the length of the data
+		$intValue  = 0;
+		$intShift  = 0;
+		$intLength = strlen($strData);
+		// Iterate over the 7-bit groups, lowest first
+		do {
+			// Make sure there is a byte
+			if ($intOffset >= $intLength) {
+				// Throw an exception
+				throw new Exception('Truncated Variant binary data.');
+			}
+			// Grab the byte
+			$intByte   = ord($strData[$intOffset++]);
+			// Add the group
+			$intValue |= (($intByte & 0x7F) << $intShift);
+			// Move to the next group
+			$intShift += 7;
+		} while ($intByte & 0x80);
+		// We're done
+		return $intValue;
+	}
+
+	//////////////////////////////////////////////////////////////////////////////
+	/// Public Static Methods ///////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////
+
+	/**
+	 * This method decodes binary data back into a Variant tree
+	 * @access public
+	 * @name VariantBinary::decode()
+	 * @param string $strData
+	 * @param array<string> $arrAllowedClasses [[]] The classes VCustom payloads may hold objects of, others come back as __PHP_Incomplete_Class
+	 * @return Variant
+	 * @static
+	 * @throws Exception
+	 */
+	public static function decode(string $strData, array<string> $arrAllowedClasses = []) : Variant
+	{
+		// Make sure the tables are built
+		self::tags();
+		// Check the header
+		if (strncmp($strData, self::Header, strlen(self::Header)) !== 0) {
+			// Throw an exception
+			throw new Exception('Data is not in the Variant binary format.');
+		}
+		// Start after the header
+		$intOffset = strlen(self::Header);
+		// Return the tree
+		return self::decodeNode($strData, $intOffset, $arrAllowedClasses);
+	}
+
+	/**
+	 * This method decodes a single node without a header, starting at $intOffset
+	 * @access public
+	 * @name VariantBinary::decodeAt()
+	 * @param string $strData
+	 * @param int $intOffset [0]
+	 * @param array<string> $arrAllowedClasses [[]] The classes VCustom payloads may hold objects of, others come back as __PHP_Incomplete_Class
+	 * @return Variant
+	 * @static
+	 * @throws Exception
+	 */
+	public static function decodeAt(string $strData, int $intOffset = 0, array<string> $arrAllowedClasses = []) : Variant
+	{
+		// Make sure the tables are built
+		self::tags();
+		// Return the node
+		return self::decodeNode($strData, $intOffset, $arrAllowedClasses);
+	}
+
+	/**
+	 * This method encodes a Variant tree into binary data
+	 * @access public
+	 * @name VariantBinary::encode()
+	 * @param Variant $varValue
+	 * @return string
+	 * @static
+	 */
+	public static function encode(Variant $varValue) : string
+	{
+		// Return the header and the tree
+		return self::Header.self::encodeBare($varValue);
+	}
+
+	/**
+	 * This method encodes a single node without a header
+	 * @access public
+	 * @name VariantBinary::encodeBare()
+	 * @param Variant $varValue
+	 * @return string
+	 * @static
+	 */
+	public static function encodeBare(Variant $varValue) : string
+	{
+		// Make sure the tables are built
+		self::tags();
+		// Return the node
+		return self::encodeNode($varValue);
+	}
+}
@@ -0,0 +1,512 @@
+<?hh
+
+///////////////////////////////////////////////////////////////////////////////
+/// VariantJsonReader Class Definition ///////////////////////////////////////
+/////////////////////////////////////////////////////////////////////////////
+
+class VariantJsonReader
+{
+	//////////////////////////////////////////////////////////////////////////////
+	/// Constants ///////////////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////
+
+	/**
+	 * This constant marks a subtree that is materialized in full
+	 * @name VariantJsonReader::ModeKeep
+	 * @var int
+	 */
+	const int ModeKeep = 0;
+
+	/**
+	 * This constant marks a subtree that is an ancestor of a path filter, only its matching children are materialized
+	 * @name VariantJsonReader::ModePath
+	 * @var int
+	 */
+	const int ModePath = 1;
+
+	/**
+	 * This constant marks a subtree that is parsed and thrown away
+	 * @name VariantJsonReader::ModeSkip
+	 * @var int
+	 */
+	const int ModeSkip = 2;
+
+	//////////////////////////////////////////////////////////////////////////////
+	/// Properties //////////////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////
+
+	/**
+	 * This property contains the unread part of the input
+	 * @access protected
+	 * @name VariantJsonReader::$mBuffer
+	 * @var string
+	 */
+	protected string $mBuffer                = '';
+
+	/**
+	 * This property contains the number of bytes read from the stream at a time
+	 * @access protected
+	 * @name VariantJsonReader::$mChunkSize
+	 * @var int
+	 */
+	protected int $mChunkSize                = 65536;
+
+	/**
+	 * This property contains the number of bytes dropped from the front of the buffer, for error offsets
+	 * @access protected
+	 * @name VariantJsonReader::$mConsumed
+	 * @var int
+	 */
+	protected int $mConsumed                 = 0;
+
+	/**
+	 * This property tells the instance whether or not the stream has been read to the end
+	 * @access protected
+	 * @name VariantJsonReader::$mEnd
+	 * @var bool
+	 */
+	protected bool $mEnd                     = false;
+
+	/**
+	 * This property contains the read position in the buffer
+	 * @access protected
+	 * @name VariantJsonReader::$mOffset
+	 * @var int
+	 */
+	protected int $mOffset                   = 0;
+
+	/**
+	 * This property contains the path filters split into segments, null to materialize everything
+	 * @access protected
+	 * @name VariantJsonReader::$mPaths
+	 * @var HH\Vector<HH\Vector<string>>
+	 */
+	protected ?Vector<Vector<string>> $mPaths = null;
+
+	/**
+	 * This property contains the stream the JSON is read from
+	 * @access protected
+	 * @name VariantJsonReader::$mStream
+	 * @var resource
+	 */
+	protected resource $mStream;
+
+	//////////////////////////////////////////////////////////////////////////////
+	/// Constructor /////////////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////
+
+	/**
+	 * This method sets up the reader with a stream and optional path filters like "data.items.*.name"
+	 * @access public
+	 * @name VariantJsonReader::__construct()
+	 * @param resource $rscStream
+	 * @param Traversable<string> $trvPaths [null]
+	 * @param int $intChunkSize [65536]
+	 * @return void
+	 */
+	public function __construct(resource $rscStream, ?Traversable<string> $trvPaths = null, int $intChunkSize = 65536) : void
+	{
+		// Set the stream into the instance
+		$this->mStream    = $rscStream;
+		// Set the chunk size into the instance
+		$this->mChunkSize = $intChunkSize;
+		// Check for path filters
+		if ($trvPaths !== null) {
+			// Create the filters
+			$this->mPaths = Vector {};
+			// Iterate over the paths
+			foreach ($trvPaths as $strPath) {
+				// Split the path into its segments
+				$this->mPaths->add(new Vector(explode('.', $strPath)));
+			}
+		}
+	}
+
+	//////////////////////////////////////////////////////////////////////////////
+	/// Static Constructor //////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////
+
+	/**
+	 * This method instantiates and sets up the reader with a stream and optional path filters
+	 * @access public
+	 * @name VariantJsonReader::Factory()
+	 * @param resource $rscStream
+	 * @param Traversable<string> $trvPaths [null]
+	 * @param int $intChunkSize [65536]
+	 * @return VariantJsonReader
+	 * @static
+	 */
+	public static function Factory(resource $rscStream, ?Traversable<string> $trvPaths = null, int $intChunkSize = 65536) : VariantJsonReader
+	{
+		// Return the new instance
+		return new self($rscStream, $trvPaths, $intChunkSize);
+	}
+
+	//////////////////////////////////////////////////////////////////////////////
+	/// Public Static Methods ///////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////
+
+	/**
+	 * This method reads a JSON file into a Variant tree
+	 * @access public
+	 * @name VariantJsonReader::fromFile()
+	 * @param string $strFile
+	 * @param Traversable<string> $trvPaths [null]
+	 * @return Variant
+	 * @static
+	 * @throws Exception
+	 */
+	public static function fromFile(string $strFile, ?Traversable<string> $trvPaths = null) : Variant
+	{
+		// Open the file
+		$rscStream = fopen($strFile, 'rb');
+		// Make sure the file opened
+		if ($rscStream === false) {
+			// Throw an exception
+			throw new Exception('Unable to open '.$strFile.' for reading.');
+		}
+		// Read the file
+		try {
+			// Return the tree
+			return self::Factory($rscStream, $trvPaths)->read();
+		} finally {
+			// Close the file
+			fclose($rscStream);
+		}
+	}
+
+	//////////////////////////////////////////////////////////////////////////////
+	/// Protected Methods ///////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////
+
+	/**
+	 * This method consumes an expected character
+	 * @access protected
+	 * @name VariantJsonReader::expect()
+	 * @param string $strCharacter
+	 * @return void
+	 * @throws Exception
+	 */
+	protected function expect(string $strCharacter) : void
+	{
+		// Check the next character
+		if ($this->peek() !== $strCharacter) {
+			// Throw an exception
+			throw new Exception('Expected "'.$strCharacter.'" at byte '.($this->mConsumed + $this->mOffset).'.');
+		}
+		// Consume the character
+		++$this->mOffset;
+	}
+
+	/**
+	 * This method appends the next chunk of the stream to the buffer
+	 * @access protected
+	 * @name VariantJsonReader::more()
+	 * @return bool Whether or not anything was read
+	 */
+	protected function more() : bool
+	{
+		// Check for the end of the stream
+		if ($this->mEnd) {
+			// We're done
+			return false;
+		}
+		// Read the chunk
+		$strChunk = fread($this->mStream, $this->mChunkSize);
+		// Check for data
+		if (($strChunk === false) || ($strChunk === '')) {
+			// The stream is done
+			$this->mEnd = feof($this->mStream) || ($strChunk === false);
+			// We're done
+			return false;
+		}
+		// Append the chunk
+		$this->mBuffer .= $strChunk;
+		// We're done
+		return true;
+	}
+
+	/**
+	 * This method skips whitespace and returns the next character without consuming it, an empty string at the end of the input
+	 * @access protected
+	 * @name VariantJsonReader::peek()
+	 * @return string
+	 */
+	protected function peek() : string
+	{
+		// Drop what has been read, this is the only place positions can move
+		if ($this->mOffset >= $this->mChunkSize) {
+			// Count the dropped bytes
+			$this->mConsumed += $this->mOffset;
+			// Reset the buffer
+			$this->mBuffer    = (string) substr($this->mBuffer, $this->mOffset);
+			$this->mOffset    = 0;
+		}
+		// Iterate until a character is found
+		do {
+			// Skip the whitespace
+			$this->mOffset += strspn($this->mBuffer, " \t\r\n", $this->mOffset);
+			// Check for a character
+			if ($this->mOffset < strlen($this->mBuffer)) {
+				// Return the character
+				return $this->mBuffer[$this->mOffset];
+			}
+		} while ($this->more());
+		// We're done
+		return '';
+	}
+
+	/**
+	 * This method reads a scalar token, a number, true, false or null
+	 * @access protected
+	 * @name VariantJsonReader::readLiteral()
+	 * @return mixed
+	 * @throws Exception
+	 */
+	protected function readLiteral() : mixed
+	{
+		// Find the end of the token, reading more if it runs to the end of the buffer
+		do {
+			// Measure the token
+			$intLength = strspn($this->mBuffer, '+-.0123456789Eaeflnrstu', $this->mOffset);
+		} while ((($this->mOffset + $intLength) === strlen($this->mBuffer)) && $this->more());
+		// Grab the token
+		$strToken = substr($this->mBuffer, $this->mOffset, $intLength);
+		// Decode the token
+		$mixValue = json_decode($strToken, true);
+		// Make sure the token was valid
+		if (($intLength === 0) || (($mixValue === null) && ($strToken !== 'null'))) {
+			// Throw an exception
+			throw new Exception('Invalid JSON value at byte '.($this->mConsumed + $this->mOffset).'.');
+		}
+		// Consume the token
+		$this->mOffset += $intLength;
+		// We're done
+		return $mixValue;
+	}
+
+	/**
+	 * This method reads a string token
+	 * @access protected
+	 * @name VariantJsonReader::readString()
+	 * @return string
+	 * @throws Exception
+	 */
+	protected function readString() : string
+	{
+		// Start searching after the opening quote
+		$intSearch = ($this->mOffset + 1);
+		// Iterate until the closing quote is found
+		while (true) {
+			// Find the next quote
+			$intQuote = strpos($this->mBuffer, '"', $intSearch);
+			// Check for a quote
+			if ($intQuote === false) {
+				// Continue from the end of the buffer once more has been read
+				$intSearch = strlen($this->mBuffer);
+				// Read more
+				if ($this->more() === false) {
+					// Throw an exception
+					throw new Exception('Unterminated JSON string at byte '.($this->mConsumed + $this->mOffset).'.');
+				}
+				// Search again
+				continue;
+			}
+			// Count the backslashes in front of the quote
+			$intSlashes = 0;
+			// Iterate backwards
+			while ($this->mBuffer[$intQuote - $intSlashes - 1] === '\\') {
+				// Count the backslash
+				++$intSlashes;
+			}
+			// An even number of backslashes means the quote is not escaped
+			if (($intSlashes % 2) === 0) {
+				// We're done
+				break;
+			}
+			// Search past the escaped quote
+			$intSearch = ($intQuote + 1);
+		}
+		// Grab the token, quotes included
+		$strToken = substr($this->mBuffer, $this->mOffset, ($intQuote - $this->mOffset + 1));
+		// Consume the token
+		$this->mOffset = ($intQuote + 1);
+		// Check for escapes
+		if (strpos($strToken, '\\') === false) {
+			// Return the string as-is
+			return (string) substr($strToken, 1, -1);
+		}
+		// Return the decoded string
+		return (string) json_decode($strToken);
+	}
+
+	/**
+	 * This method determines how a child of a subtree that is an ancestor of a path filter is handled
+	 * @access protected
+	 * @name VariantJsonReader::modeFor()
+	 * @param HH\Vector<string> $vecPath
+	 * @return int
+	 */
+	protected function modeFor(Vector<string> $vecPath) : int
+	{
+		// Start out skipping the child
+		$intMode = self::ModeSkip;
+		// Iterate over the filters
+		foreach ($this->mPaths->getIterator() as $vecFilter) {
+			// Check for a filter too short to reach the child
+			if ($vecFilter->count() < $vecPath->count()) {
+				// Next filter
+				continue;
+			}
+			// Localize the match
+			$blnMatch = true;
+			// Iterate over the segments of the child's path
+			foreach ($vecPath->getIterator() as $intSegment => $strSegment) {
+				// Check the segment
+				if (($vecFilter->at($intSegment) !== '*') && ($vecFilter->at($intSegment) !== $strSegment)) {
+					// No match
+					$blnMatch = false;
+					// We're done
+					break;
+				}
+			}
+			// Check for a match
+			if ($blnMatch && ($vecFilter->count() === $vecPath->count())) {
+				// The filter selects the child itself
+				return self::ModeKeep;
+			} elseif ($blnMatch) {
+				// The filter selects something below the child
+				$intMode = self::ModePath;
+			}
+		}
+		// We're done
+		return $intMode;
+	}
+
+	//////////////////////////////////////////////////////////////////////////////
+	/// Public Methods //////////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////
+
+	/**
+	 * This method reads one JSON document from the stream and builds the VariantMap/VariantList tree as it goes
+	 * @access public
+	 * @name VariantJsonReader::read()
+	 * @return Variant
+	 * @throws Exception
+	 */
+	public function read() : Variant
+	{
+		// Localize the root
+		$varRoot  = null;
+		// Create the stack of open objects and arrays
+		$vecStack = Vector {};
+		// Iterate until the root is complete
+		do {
+			// Localize the parent and the key of the next value
+			$mapFrame = ($vecStack->isEmpty() ? null : $vecStack->at($vecStack->count() - 1));
+			$mixKey   = null;
+			// Check for a parent
+			if ($mapFrame !== null) {
+				// Check for the end of the parent
+				if ($this->peek() === ($mapFrame->at('map') ? '}' : ']')) {
+					// Consume the character
+					++$this->mOffset;
+					// Close the parent
+					$vecStack->pop();
+					// Next value
+					continue;
+				}
+				// Check for a preceding value
+				if ($mapFrame->at('count') > 0) {
+					// Consume the comma
+					$this->expect(',');
+				}
+				// Check for an object
+				if ($mapFrame->at('map')) {
+					// Make sure we have a key
+					if ($this->peek() !== '"') {
+						// Throw an exception
+						throw new Exception('Expected an object key at byte '.($this->mConsumed + $this->mOffset).'.');
+					}
+					// Read the key
+					$mixKey = $this->readString();
+					// Consume the colon
+					$this->expect(':');
+				} else {
+					// The key is the index
+					$mixKey = $mapFrame->at('count');
+				}
+				// Count the value
+				$mapFrame->set('count', ($mapFrame->at('count') + 1));
+			}
+			// Determine how the value is handled
+			$intMode = self::ModeKeep;
+			$vecPath = null;
+			// Check for a parent
+			if (($mapFrame !== null) && ($mapFrame->at('mode') === self::ModePath)) {
+				// Extend the parent's path
+				$vecPath = $mapFrame->at('path')->toVector();
+				$vecPath->add((string) $mixKey);
+				// Match the path against the filters
+				$intMode = $this->modeFor($vecPath);
+			} elseif ($mapFrame !== null) {
+				// Inherit the parent's mode
+				$intMode = $mapFrame->at('mode');
+			} elseif ($this->mPaths !== null) {
+				// The root holds every filter
+				$intMode = self::ModePath;
+				$vecPath = Vector {};
+			}
+			// Grab the first character of the value
+			$strCharacter = $this->peek();
+			// Check for an object or an array
+			if (($strCharacter === '{') || ($strCharacter === '[')) {
+				// Consume the character
+				++$this->mOffset;
+				// Create the container unless it is skipped
+				$varNode = (($intMode === self::ModeSkip) ? null : (($strCharacter === '{') ? new VariantMap() : new VariantList()));
+				// Check for a container and a parent
+				if (($varNode !== null) && ($mapFrame !== null)) {
+					// Attach the container to its parent
+					if ($mapFrame->at('map')) {
+						// Set the container
+						$mapFrame->at('node')->setVariant($mixKey, $varNode);
+					} else {
+						// Add the container
+						$mapFrame->at('node')->addVariant($varNode);
+					}
+				} elseif ($mapFrame === null) {
+					// This is the root
+					$varRoot = $varNode;
+				}
+				// Open the container
+				$vecStack->add(Map {
+					'count' => 0,
+					'map'   => ($strCharacter === '{'),
+					'mode'  => $intMode,
+					'node'  => $varNode,
+					'path'  => $vecPath
+				});
+			} elseif ($strCharacter === '') {
+				// Throw an exception
+				throw new Exception('Unexpected end of JSON input.');
+			} else {
+				// Read the scalar
+				$mixValue = (($strCharacter === '"') ? $this->readString() : $this->readLiteral());
+				// Check for a parent
+				if ($mapFrame === null) {
+					// The scalar is the root
+					$varRoot = Variant::Factory($mixValue);
+				} elseif (($intMode === self::ModeKeep) && $mapFrame->at('map')) {
+					// Set the value
+					$mapFrame->at('node')->set($mixKey, $mixValue);
+				} elseif ($intMode === self::ModeKeep) {
+					// Add the value
+					$mapFrame->at('node')->add($mixValue);
+				}
+			}
+		} while ($vecStack->isEmpty() === false);
+		// We're done
+		return $varRoot;
+	}
+}
@@ -0,0 +1,262 @@
+<?hh
+
+///////////////////////////////////////////////////////////////////////////////
+/// VariantJsonWriter Class Definition ///////////////////////////////////////
+/////////////////////////////////////////////////////////////////////////////
+
+class VariantJsonWriter
+{
+	//////////////////////////////////////////////////////////////////////////////
+	/// Properties //////////////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////
+
+	/**
+	 * This property contains the output that has not been sent to the sink yet
+	 * @access protected
+	 * @name VariantJsonWriter::$mBuffer
+	 * @var string
+	 */
+	protected string $mBuffer   = '';
+
+	/**
+	 * This property contains the number of bytes sent to the sink
+	 * @access protected
+	 * @name VariantJsonWriter::$mBytes
+	 * @var int
+	 */
+	protected int $mBytes       = 0;
+
+	/**
+	 * This property contains the size the buffer grows to before it is sent to the sink
+	 * @access protected
+	 * @name VariantJsonWriter::$mChunkSize
+	 * @var int
+	 */
+	protected int $mChunkSize   = 65536;
+
+	/**
+	 * This property contains the sink, either a writable stream or a callable that takes each chunk
+	 * @access protected
+	 * @name VariantJsonWriter::$mSink
+	 * @var resource|callable
+	 */
+	protected mixed $mSink      = null;
+
+	//////////////////////////////////////////////////////////////////////////////
+	/// Constructor /////////////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////
+
+	/**
+	 * This method sets up the writer with a sink
+	 * @access public
+	 * @name VariantJsonWriter::__construct()
+	 * @param resource|callable $mixSink
+	 * @param int $intChunkSize [65536]
+	 * @return void
+	 * @throws Exception
+	 */
+	public function __construct(mixed $mixSink, int $intChunkSize = 65536) : void
+	{
+		// Make sure we have a sink
+		if ((is_resource($mixSink) || is_callable($mixSink)) === false) {
+			// Throw an exception
+			throw new Exception('VariantJsonWriter needs a stream or a callable to write to.');
+		}
+		// Set the sink into the instance
+		$this->mSink      = $mixSink;
+		// Set the chunk size into the instance
+		$this->mChunkSize = $intChunkSize;
+	}
+
+	//////////////////////////////////////////////////////////////////////////////
+	/// Static Constructor //////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////
+
+	/**
+	 * This method instantiates and sets up the writer with a sink
+	 * @access public
+	 * @name VariantJsonWriter::Factory()
+	 * @param resource|callable $mixSink
+	 * @param int $intChunkSize [65536]
+	 * @return VariantJsonWriter
+	 * @static
+	 */
+	public static function Factory(mixed $mixSink, int $intChunkSize = 65536) : VariantJsonWriter
+	{
+		// Return the new instance
+		return new self($mixSink, $intChunkSize);
+	}
+
+	//////////////////////////////////////////////////////////////////////////////
+	/// Protected Methods ///////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////
+
+	/**
+	 * This method appends output to the buffer and sends it to the sink once it is a full chunk
+	 * @access protected
+	 * @name VariantJsonWriter::emit()
+	 * @param string $strOutput
+	 * @return void
+	 */
+	protected function emit(string $strOutput) : void
+	{
+		// Append the output
+		$this->mBuffer .= $strOutput;
+		// Check the size of the buffer
+		if (strlen($this->mBuffer) >= $this->mChunkSize) {
+			// Send the chunk
+			$this->flush();
+		}
+	}
+
+	/**
+	 * This method encodes a single raw value
+	 * @access protected
+	 * @name VariantJsonWriter::encode()
+	 * @param mixed $mixValue
+	 * @return string
+	 * @throws Exception
+	 */
+	protected function encode(mixed $mixValue) : string
+	{
+		// Encode the value
+		$strJson = json_encode($mixValue);
+		// Make sure it encoded
+		if ($strJson === false) {
+			// Throw an exception
+			throw new Exception('Unable to encode value as JSON: '.json_last_error_msg());
+		}
+		// We're done
+		return $strJson;
+	}
+
+	/**
+	 * This method writes a Variant and everything below it
+	 * @access protected
+	 * @name VariantJsonWriter::writeVariant()
+	 * @param Variant $varValue
+	 * @return void
+	 */
+	protected function writeVariant(Variant $varValue) : void
+	{
+		// Check for a map
+		if ($varValue instanceof VariantMap) {
+			// Open the object
+			$this->emit('{');
+			// Localize the separator, empty for the first key
+			$strSeparator = '';
+			// Iterate over the map
+			foreach ($varValue->getIterator() as $strKey => $varChild) {
+				// Write the key
+				$this->emit($strSeparator.$this->encode((string) $strKey).':');
+				// Write the value
+				$this->writeVariant($varChild);
+				// Reset the separator
+				$strSeparator = ',';
+			}
+			// Close the object
+			$this->emit('}');
+		} elseif ($varValue instanceof VariantList) {
+			// Open the array
+			$this->emit('[');
+			// Localize the separator, empty for the first element
+			$strSeparator = '';
+			// Iterate over the list
+			foreach ($varValue->getIterator() as $varChild) {
+				// Write the separator
+				$this->emit($strSeparator);
+				// Write the value
+				$this->writeVariant($varChild);
+				// Reset the separator
+				$strSeparator = ',';
+			}
+			// Close the array
+			$this->emit(']');
+		} else {
+			// Write the raw value
+			$this->emit($this->encode($varValue->getData()));
+		}
+	}
+
+	//////////////////////////////////////////////////////////////////////////////
+	/// Public Methods //////////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////
+
+	/**
+	 * This method sends whatever is left in the buffer to the sink
+	 * @access public
+	 * @name VariantJsonWriter::flush()
+	 * @return VariantJsonWriter $this
+	 * @throws Exception
+	 */
+	public function flush() : VariantJsonWriter
+	{
+		// Check for output
+		if ($this->mBuffer === '') {
+			// We're done
+			return $this;
+		}
+		// Check the sink
+		if (is_resource($this->mSink)) {
+			// Localize the bytes written so far
+			$intWritten = 0;
+			// Iterate until the whole chunk is written, streams may take part of it
+			while ($intWritten < strlen($this->mBuffer)) {
+				// Write what is left of the chunk
+				$mixWritten = fwrite($this->mSink, substr($this->mBuffer, $intWritten));
+				// Make sure the stream took something, a stream that takes nothing would never finish
+				if (($mixWritten === false) || ($mixWritten === 0)) {
+					// Throw an exception
+					throw new Exception('Unable to write to the JSON sink, '.$intWritten.' of '.strlen($this->mBuffer).' bytes were written.');
+				}
+				// Count the bytes
+				$intWritten += $mixWritten;
+			}
+		} else {
+			// Send the chunk
+			call_user_func($this->mSink, $this->mBuffer);
+		}
+		// Count the bytes
+		$this->mBytes += strlen($this->mBuffer);
+		// Reset the buffer
+		$this->mBuffer = '';
+		// We're done
+		return $this;
+	}
+
+	/**
+	 * This method writes a Variant tree as JSON to the sink
+	 * @access public
+	 * @name VariantJsonWriter::write()
+	 * @param Variant $varRoot
+	 * @return int The number of bytes written by this call
+	 * @throws Exception
+	 */
+	public function write(Variant $varRoot) : int
+	{
+		// Localize the bytes written so far
+		$intBytes = $this->mBytes;
+		// Write the tree
+		$this->writeVariant($varRoot);
+		// Send the remainder
+		$this->flush();
+		// We're done
+		return ($this->mBytes - $intBytes);
+	}
+
+	//////////////////////////////////////////////////////////////////////////////
+	/// Getters /////////////////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////
+
+	/**
+	 * This method returns the number of bytes sent to the sink
+	 * @access public
+	 * @name VariantJsonWriter::getBytes()
+	 * @return int
+	 */
+	public function getBytes() : int
+	{
+		// Return the byte count
+		return $this->mBytes;
+	}
+}
@@ -1,5 +1,26 @@
 <?hh
 
+///////////////////////////////////////////////////////////////////////////////
+/// Enumerations /////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////////////////
+
+/**
+ * This enumeration contains the aggregates VariantList::groupedAggregateMap() can compute
+ * @enum
+ * @name Aggregate {}
+ * @var enum<string>
+ */
+enum Aggregate : string
+{
+	ACount = 'count';
+	AMax   = 'max';
+	AMin   = 'min';
+	ASum   = 'sum';
+};
+
+///////////////////////////////////////////////////////////////////////////////
+/// VariantList Class Definition /////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////////////////
 
 class VariantList extends Variant
 {
@@ -7,6 +28,13 @@ class VariantList extends Variant
 	/// Properties //////////////////////////////////////////////////////////////
 	////////////////////////////////////////////////////////////////////////////
 
+	/**
+	 * This property contains the type every value shares while the vector holds them raw as a packed column, null elsewise
+	 * @access protected
+	 * @name VariantList::$mColumnType
+	 * @var Type
+	 */
+	protected ?Type $mColumnType     = null;
 
 	/**
 	 * This property contains the data for this map
@@ -16,23 +44,92 @@ class VariantList extends Variant
 	 */
 	protected Vector<Variant> $mData = Vector {};
 
+	/**
+	 * This property caches the immutable view built by getImmutableData(), null while it is out of date
+	 * @access protected
+	 * @name VariantList::$mDataCache
+	 * @var HH\ImmVector<mixed>
+	 */
+	protected ?ImmVector<mixed> $mDataCache = null;
+
+	/**
+	 * This property contains the change stamp the cached view is current as of
+	 * @access protected
+	 * @name VariantList::$mDataRevision
+	 * @var int
+	 */
+	protected int $mDataRevision     = 0;
+
+	/**
+	 * This property contains the conversion kernel for each pair of scalar types, they match what Variant::convert() does for one value
+	 * @access protected
+	 * @name VariantList::$mKernels
+	 * @var HH\Map<Type, HH\Map<Type, string>>
+	 */
+	protected static Map<Type, Map<Type, string>> $mKernels = Map {
+		Type::VBoolean => Map { Type::VDouble => 'doubleval', Type::VFloat => 'floatval', Type::VInteger => 'intval', Type::VString => 'strval' },
+		Type::VDouble  => Map { Type::VBoolean => 'boolval', Type::VFloat => 'floatval', Type::VInteger => 'intval', Type::VString => 'strval' },
+		Type::VFloat   => Map { Type::VBoolean => 'boolval', Type::VDouble => 'doubleval', Type::VInteger => 'intval', Type::VString => 'strval' },
+		Type::VInteger => Map { Type::VBoolean => 'boolval', Type::VDouble => 'doubleval', Type::VFloat => 'floatval', Type::VString => 'strval' },
+		Type::VNull    => Map { Type::VBoolean => 'boolval', Type::VInteger => 'intval', Type::VString => 'strval' },
+		Type::VString  => Map { Type::VBinary => 'strval', Type::VBoolean => 'boolval', Type::VDouble => 'doubleval', Type::VFloat => 'floatval', Type::VInteger => 'intval' }
+	};
+
+	/**
+	 * This property tells the instance whether or not the values in the vector may still be raw or interned, they are wrapped or copied on first access
+	 * @access protected
+	 * @name VariantList::$mLazy
+	 * @var bool
+	 */
+	protected bool $mLazy            = false;
+
+	/**
+	 * This property contains the newest change stamp found in the vector and everything below it the last time it was looked for
+	 * @access protected
+	 * @name VariantList::$mTreeRevision
+	 * @var int
+	 */
+	protected int $mTreeRevision     = 0;
+
+	/**
+	 * This property contains the change count VariantList::$mTreeRevision was taken at, it stays good until anything changes again
+	 * @access protected
+	 * @name VariantList::$mTreeRevisionAt
+	 * @var int
+	 */
+	protected int $mTreeRevisionAt   = -1;
+
 	//////////////////////////////////////////////////////////////////////////////
 	/// Constructor /////////////////////////////////////////////////////////////
 	////////////////////////////////////////////////////////////////////////////
 
 	/**
 	 * This method sets up the instance with existing data
+	 * Values that all share one scalar type are kept raw as a packed column, the first at() or iteration unpacks it into a lazy vector so the Variants handed out are the stored ones
 	 * @access public
 	 * @name VariantList::__construct()
 	 * @param KeyedTraversable<Tk, Tv> $ktsSource [null]
+	 * @param bool $blnLazy [false]
 	 * @return void
 	 */
-	public function __construct(?Traversable<Tv> $ktsSource = null) : Variant
+	public function __construct(?Traversable<Tv> $ktsSource = null, bool $blnLazy = false) : Variant
 	{
 		// Check for data
 		if (is_null($ktsSource) === false) {
 			// Create a new map out of the
 			$this->mData = new Vector($ktsSource);
+			// Check for a packed list whose values all share one scalar type
+			if (($this->mColumnType = self::detectColumnType($this->mData)) !== null) {
+				// Keep the raw column until a value is reached
+				return $this;
+			}
+			// Check for lazy wrapping
+			if ($blnLazy) {
+				// Keep the raw values until they are reached
+				$this->mLazy = true;
+				// We're done
+				return $this;
+			}
 			// Iterate over the map
 			foreach ($this->mData->getIterator() as $intIndex => $mixValue) {
 				// Reset the data
@@ -55,13 +152,14 @@ class VariantList extends Variant
 	 * @access public
 	 * @name VariantList::Factory()
 	 * @param mixed $tvsSource
+	 * @param bool $blnLazy [false]
 	 * @return VariantList
 	 * @static
 	 */
-	public static function Factory(mixed $tvsSource) : VariantList
+	public static function Factory(mixed $tvsSource, bool $blnLazy = false) : VariantList
 	{
 		// Return the new instance
-		return new self($tvsSource);
+		return new self($tvsSource, $blnLazy);
 	}
 
 	//////////////////////////////////////////////////////////////////////////////
@@ -73,13 +171,14 @@ class VariantList extends Variant
 	 * @access public
 	 * @name VariantList::fromArray()
 	 * @param array<string, mixed> $arrSource
+	 * @param bool $blnLazy [false]
 	 * @return VariantList
 	 * @static
 	 */
-	public static function fromArray(array<mixed> $arrSource) : VariantList
+	public static function fromArray(array<mixed> $arrSource, bool $blnLazy = false) : VariantList
 	{
 		// Return the new instance
-		return new self($arrSource);
+		return new self($arrSource, $blnLazy);
 	}
 
 	/**
@@ -87,13 +186,286 @@ class VariantList extends Variant
 	 * @access public
 	 * @name VariantList::fromVector()
 	 * @param HH\Vector<mixed> $vecSource
+	 * @param bool $blnLazy [false]
 	 * @return VariantList
 	 * @static
 	 */
-	public static function fromVector(Vector<mixed> $vecSource) : VariantList
+	public static function fromVector(Vector<mixed> $vecSource, bool $blnLazy = false) : VariantList
 	{
 		// Return the new instance
-		return new self($vecSource);
+		return new self($vecSource, $blnLazy);
+	}
+
+	//////////////////////////////////////////////////////////////////////////////
+	/// Protected Static Methods ////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////
+
+	/**
+	 * This method returns the type a raw value is stored as in a packed column, null for values that need a Variant
+	 * Strings that look like JSON objects are never packed, a Variant types them as JSON, which converts differently than a string
+	 * @access protected
+	 * @name VariantList::columnTypeOf()
+	 * @param mixed $mixValue
+	 * @return Type
+	 * @static
+	 */
+	protected static function columnTypeOf(mixed $mixValue) : ?Type
+	{
+		// Check the type
+		if (is_int($mixValue)) {
+			// Return the integer column
+			return Type::VInteger;
+		} elseif (is_string($mixValue)) {
+			// Return the string column, unless the string may be typed as JSON
+			return (self::looksLikeJson($mixValue) ? null : Type::VString);
+		} elseif (is_float($mixValue)) {
+			// Return the double column
+			return Type::VDouble;
+		} elseif (is_bool($mixValue)) {
+			// Return the boolean column
+			return Type::VBoolean;
+		}
+		// Everything else is wrapped
+		return null;
+	}
+
+	/**
+	 * This method returns the column type every raw value in a vector shares, null if they differ, need a Variant or there are none
+	 * @access protected
+	 * @name VariantList::detectColumnType()
+	 * @param HH\Vector<mixed> $vecData
+	 * @return Type
+	 * @static
+	 */
+	protected static function detectColumnType(Vector<mixed> $vecData) : ?Type
+	{
+		// Localize the column type
+		$typeColumn = null;
+		// Iterate over the values
+		foreach ($vecData->getIterator() as $mixValue) {
+			// Grab the type of the value
+			$typeValue = self::columnTypeOf($mixValue);
+			// Check for a value that does not fit the column
+			if (($typeValue === null) || (($typeColumn !== null) && ($typeValue !== $typeColumn))) {
+				// We're done
+				return null;
+			}
+			// Set the column type
+			$typeColumn = $typeValue;
+		}
+		// We're done
+		return $typeColumn;
+	}
+
+	/**
+	 * This method builds the key a number is compared by loosely, integral values share the key of the integer so 1 and 1.0 are equal
+	 * @access protected
+	 * @name VariantList::looseNumberKey()
+	 * @param num $numValue
+	 * @return string
+	 * @static
+	 */
+	protected static function looseNumberKey(num $numValue) : string
+	{
+		// Check for an integer, or a float that holds one exactly
+		if (is_int($numValue) || ((floor($numValue) === $numValue) && (abs($numValue) < 9007199254740992.0))) {
+			// Return the integer key
+			return 'i'.((int) $numValue);
+		}
+		// Return the float key from its exact bytes
+		return 'd'.pack('d', $numValue);
+	}
+
+	//////////////////////////////////////////////////////////////////////////////
+	/// Protected Methods ///////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////
+
+	/**
+	 * This method converts a run of raw values that share a scalar source type with one kernel
+	 * The run is counted in VariantStats like the same number of Variant::convert() calls would be
+	 * @access protected
+	 * @name VariantList::convertRun()
+	 * @param array<mixed> $arrRun
+	 * @param Type $typeSource
+	 * @param Type $typeTarget
+	 * @return array<mixed>
+	 */
+	protected function convertRun(array<mixed> $arrRun, Type $typeSource, Type $typeTarget) : array<mixed>
+	{
+		// Check for counting
+		if (VariantStats::enabled()) {
+			// Count the conversions by their pair of types
+			VariantStats::increment('convert.'.$typeSource.'>'.$typeTarget, count($arrRun));
+		}
+		// Check for values that already have the target type
+		if ($typeSource === $typeTarget) {
+			// We're done
+			return $arrRun;
+		}
+		// Check for a conversion that is not allowed
+		if (self::canConvert($typeSource, $typeTarget) === false) {
+			// Grab the null type for the target
+			$mixNull = self::$mNullTypes->get($typeTarget);
+			// Check for a scalar null type
+			if (is_object($mixNull) === false) {
+				// Fill the run
+				return array_fill(0, count($arrRun), $mixNull);
+			}
+			// The table is shared by every instance, so give each value its own copy
+			return array_map(($mixValue) ==> clone $mixNull, $arrRun);
+		}
+		// Grab the kernel
+		$strKernel = self::$mKernels->at($typeSource)->get($typeTarget);
+		// Check for a target Variant::convert() returns null for, such as VNull
+		if ($strKernel === null) {
+			// Fill the run
+			return array_fill(0, count($arrRun), null);
+		}
+		// Convert the run
+		return array_map($strKernel, $arrRun);
+	}
+
+	/**
+	 * This method returns the Variant stored at an index, wrapping a raw value the first time it is reached
+	 * @access protected
+	 * @name VariantList::fetch()
+	 * @param int $intKey
+	 * @return Variant
+	 */
+	protected function fetch(int $intKey) : Variant
+	{
+		// Grab the value
+		$mixValue = $this->mData->at($intKey);
+		// Check for an existing Variant that is not shared
+		if (($mixValue instanceof Variant) && ($mixValue->mInterned === false)) {
+			// We're done
+			return $mixValue;
+		}
+		// Unpack the column, if any, so the Variant handed out is the one that is stored
+		$this->leaveColumn();
+		// Wrap the value, its children stay lazy as well, and swap a shared Variant for a private copy so changes to it stay in this vector
+		$varValue = (($mixValue instanceof Variant) ? $mixValue : Variant::Factory($mixValue, true))->unshare();
+		// Keep the wrapped value for the next access
+		$this->mData->set($intKey, $varValue);
+		// We're done
+		return $varValue;
+	}
+
+	/**
+	 * This method walks a VariantList<VariantMap> and yields the Variant at $strKey in each row, null for rows without it
+	 * @access protected
+	 * @name VariantList::columnIterator()
+	 * @param string $strKey
+	 * @return KeyedIterator<int, ?Variant>
+	 */
+	protected function columnIterator(string $strKey) : KeyedIterator<int, ?Variant>
+	{
+		// Iterate over the rows
+		foreach ($this->getIterator() as $intIndex => $varRow) {
+			// Check for a map with the key
+			if (($varRow instanceof VariantMap) && (($strRealKey = $varRow->search($strKey)) !== null)) {
+				// Keep the real key, the next row most likely uses the same case
+				$strKey = $strRealKey;
+				// Yield the value
+				yield $intIndex => $varRow->at($strRealKey);
+			} else {
+				// Yield the gap
+				yield $intIndex => null;
+			}
+		}
+	}
+
+	/**
+	 * This method walks the vector and wraps each raw value as the iteration reaches it
+	 * @access protected
+	 * @name VariantList::lazyIterator()
+	 * @return KeyedIterator<int, Variant>
+	 */
+	protected function lazyIterator() : KeyedIterator<int, Variant>
+	{
+		// Iterate over the indices, the vector is written to as values are wrapped
+		for ($intIndex = 0; $intIndex < $this->mData->count(); ++$intIndex) {
+			// Yield the wrapped value
+			yield $intIndex => $this->fetch($intIndex);
+		}
+	}
+
+	/**
+	 * This method turns a packed column into a lazy vector, the raw values are wrapped as they are reached from then on
+	 * @access protected
+	 * @name VariantList::leaveColumn()
+	 * @return void
+	 */
+	protected function leaveColumn() : void
+	{
+		// Check for a packed column
+		if ($this->mColumnType === null) {
+			// We're done
+			return;
+		}
+		// Raw values are what lazy mode expects
+		$this->mColumnType = null;
+		$this->mLazy       = true;
+	}
+
+	/**
+	 * This method wraps every raw value that is left and turns lazy mode off
+	 * @access protected
+	 * @name VariantList::materialize()
+	 * @return void
+	 */
+	protected function materialize() : void
+	{
+		// Leave the packed column, if any
+		$this->leaveColumn();
+		// Check for lazy mode
+		if ($this->mLazy === false) {
+			// We're done
+			return;
+		}
+		// Iterate over the indices
+		for ($intIndex = 0; $intIndex < $this->mData->count(); ++$intIndex) {
+			// Wrap the value
+			$this->fetch($intIndex);
+		}
+		// Every value is wrapped now
+		$this->mLazy = false;
+	}
+
+	/**
+	 * This method returns the newest change stamp of the vector and every wrapped value below it, raw values never change in place
+	 * The walk is only made once per change anywhere, until then the stamp it found is returned as-is
+	 * @access protected
+	 * @name VariantList::revision()
+	 * @return int
+	 */
+	protected function revision() : int
+	{
+		// Check for a packed column, which only holds raw values
+		if ($this->mColumnType !== null) {
+			// Return the stamp of the vector itself
+			return $this->mRevision;
+		}
+		// Check for a stamp taken since the last change
+		if ($this->mTreeRevisionAt === self::$mRevisionCounter) {
+			// We're done
+			return $this->mTreeRevision;
+		}
+		// Start with the stamp of the vector itself
+		$intRevision = $this->mRevision;
+		// Iterate over the values
+		foreach ($this->mData as $mixValue) {
+			// Check for a wrapped value
+			if ($mixValue instanceof Variant) {
+				// Keep the newest stamp
+				$intRevision = max($intRevision, $mixValue->revision());
+			}
+		}
+		// Keep the stamp until the next change
+		$this->mTreeRevision   = $intRevision;
+		$this->mTreeRevisionAt = self::$mRevisionCounter;
+		// We're done
+		return $intRevision;
 	}
 
 	//////////////////////////////////////////////////////////////////////////////
@@ -109,9 +481,54 @@ class VariantList extends Variant
 	 */
 	public function add(mixed $mixValue) : VariantList
 	{
+		// Check for an empty list, which can start a packed column
+		if ($this->mData->isEmpty() && ($this->mLazy === false)) {
+			// Start the column with the type of the value
+			$this->mColumnType = self::columnTypeOf($mixValue);
+		}
+		// Check for a value that fits the packed column
+		if (($this->mColumnType !== null) && (self::columnTypeOf($mixValue) === $this->mColumnType)) {
+			// Add the raw value
+			$this->mData
+				->add($mixValue);
+			// The data has changed
+			$this->invalidate();
+			// We're done
+			return $this;
+		}
+		// Leave the packed column, if any
+		$this->leaveColumn();
+		// Wrap the value
+		$varValue = Variant::Factory($mixValue);
 		// Set the data into the instance
 		$this->mData
-			->add(Variant::Factory($mixValue));
+			->add($varValue);
+		// A shared Variant is swapped for a private copy when it is reached, so iteration has to go through fetch() from now on
+		$this->mLazy = ($this->mLazy || $varValue->mInterned);
+		// The data has changed
+		$this->invalidate();
+		// We're done
+		return $this;
+	}
+
+	/**
+	 * This method adds an existing Variant to the vector without copying it
+	 * @access public
+	 * @name VariantList::addVariant()
+	 * @param Variant $varValue
+	 * @return VariantList $this
+	 */
+	public function addVariant(Variant $varValue) : VariantList
+	{
+		// Leave the packed column, if any
+		$this->leaveColumn();
+		// Set the Variant into the instance
+		$this->mData
+			->add($varValue);
+		// A shared Variant is swapped for a private copy when it is reached, so iteration has to go through fetch() from now on
+		$this->mLazy = ($this->mLazy || $varValue->mInterned);
+		// The data has changed
+		$this->invalidate();
 		// We're done
 		return $this;
 	}
@@ -128,7 +545,7 @@ class VariantList extends Variant
 		// Check for the key
 		if ($this->contains($intKey)) {
 			// Return the data
-			return $this->mData->at($intKey);
+			return $this->fetch($intKey);
 		}
 		// Return an empty variant
 		return Variant::Factory(null);
@@ -143,11 +560,81 @@ class VariantList extends Variant
 	public function clear() : VariantList
 	{
 		// Reset the data, don't use the built-in clear() as it clears all back references as well
-		$this->mData = new VariantList();
+		$this->mColumnType = null;
+		$this->mData       = Vector {};
+		$this->mLazy       = false;
+		// The data has changed
+		$this->invalidate();
 		// We're done
 		return $this;
 	}
 
+	/**
+	 * This method extracts the values at $strKey from a VariantList<VariantMap> in their original type, null for rows without the key
+	 * @access public
+	 * @name VariantList::column()
+	 * @param string $strKey
+	 * @return HH\Vector<mixed>
+	 */
+	public function column(string $strKey) : Vector<mixed>
+	{
+		// Create the response vector
+		$vecReturn = Vector {};
+		// Reserve the indices
+		$vecReturn->reserve($this->count());
+		// Iterate over the column
+		foreach ($this->columnIterator($strKey) as $varValue) {
+			// Add the raw value
+			$vecReturn->add(($varValue === null) ? null : $varValue->getData());
+		}
+		// We're done
+		return $vecReturn;
+	}
+
+	/**
+	 * This method extracts the values at $strKey from a VariantList<VariantMap> as integers, 0 for rows without the key
+	 * @access public
+	 * @name VariantList::columnInt()
+	 * @param string $strKey
+	 * @return HH\Vector<int>
+	 */
+	public function columnInt(string $strKey) : Vector<int>
+	{
+		// Create the response vector
+		$vecReturn = Vector {};
+		// Reserve the indices
+		$vecReturn->reserve($this->count());
+		// Iterate over the column
+		foreach ($this->columnIterator($strKey) as $varValue) {
+			// Add the integer
+			$vecReturn->add(($varValue === null) ? 0 : $varValue->toInt());
+		}
+		// We're done
+		return $vecReturn;
+	}
+
+	/**
+	 * This method extracts the values at $strKey from a VariantList<VariantMap> as strings, an empty string for rows without the key
+	 * @access public
+	 * @name VariantList::columnString()
+	 * @param string $strKey
+	 * @return HH\Vector<string>
+	 */
+	public function columnString(string $strKey) : Vector<string>
+	{
+		// Create the response vector
+		$vecReturn = Vector {};
+		// Reserve the indices
+		$vecReturn->reserve($this->count());
+		// Iterate over the column
+		foreach ($this->columnIterator($strKey) as $varValue) {
+			// Add the string
+			$vecReturn->add(($varValue === null) ? '' : $varValue->toString());
+		}
+		// We're done
+		return $vecReturn;
+	}
+
 	/**
 	 * This method searches the Vector's keys to determine whether or not a key exists using case-insensitivity
 	 * @access public
@@ -175,6 +662,83 @@ class VariantList extends Variant
 		return $this->contains($intKey);
 	}
 
+	/**
+	 * This method converts every value to a type, runs of values with the same scalar type are converted with one kernel instead of per value dispatch
+	 * Values that are not scalars, and strings that may be JSON objects, are converted one by one with Variant::convert(), so the results always match it
+	 * @access public
+	 * @name VariantList::convertAll()
+	 * @param Type $typeTarget
+	 * @return HH\Vector<mixed>
+	 */
+	public function convertAll(Type $typeTarget) : Vector<mixed>
+	{
+		// Check for a packed column that already has the target type
+		if ($this->mColumnType === $typeTarget) {
+			// Check for counting
+			if (VariantStats::enabled()) {
+				// Count the conversions by their pair of types
+				VariantStats::increment('convert.'.$typeTarget.'>'.$typeTarget, $this->mData->count());
+			}
+			// Return a copy of the column
+			return $this->mData->toVector();
+		}
+		// Create the response vector
+		$vecReturn = Vector {};
+		// Reserve the indices
+		$vecReturn->reserve($this->mData->count());
+		// Localize the current run and its source type
+		$arrRun  = [];
+		$typeRun = null;
+		// Iterate over the indices
+		for ($intIndex = 0; $intIndex < $this->mData->count(); ++$intIndex) {
+			// Grab the value
+			$mixValue = $this->mData->at($intIndex);
+			// Resolve the source type, a Variant has it cached and a raw value is typed without wrapping it
+			if ($mixValue instanceof Variant) {
+				// Use the cached type
+				$typeSource = $mixValue->getType();
+			} elseif ($mixValue === null) {
+				// Nulls have their own type
+				$typeSource = Type::VNull;
+			} else {
+				// Type the raw value, strings that may be JSON are left to be detected one by one
+				$typeSource = self::columnTypeOf($mixValue);
+			}
+			// Check for a value without a kernel
+			if (($typeSource === null) || (self::$mKernels->containsKey($typeSource) === false)) {
+				// Flush the run
+				if ($typeRun !== null) {
+					// Add the converted run
+					$vecReturn->addAll($this->convertRun($arrRun, $typeRun, $typeTarget));
+				}
+				// Reset the run
+				$arrRun  = [];
+				$typeRun = null;
+				// Convert the value by itself, a raw value is wrapped without being stored so a packed column stays packed
+				$vecReturn->add((($mixValue instanceof Variant) ? $mixValue : Variant::Factory($mixValue, true))->convert($typeTarget));
+				// Next value
+				continue;
+			}
+			// Check for the end of a run
+			if (($typeRun !== null) && ($typeSource !== $typeRun)) {
+				// Add the converted run
+				$vecReturn->addAll($this->convertRun($arrRun, $typeRun, $typeTarget));
+				// Reset the run
+				$arrRun = [];
+			}
+			// Add the raw value to the run
+			$arrRun[] = (($mixValue instanceof Variant) ? $mixValue->getData() : $mixValue);
+			$typeRun  = $typeSource;
+		}
+		// Check for a run that is left
+		if ($typeRun !== null) {
+			// Add the converted run
+			$vecReturn->addAll($this->convertRun($arrRun, $typeRun, $typeTarget));
+		}
+		// We're done
+		return $vecReturn;
+	}
+
 	/**
 	 * This method returns the number or indices the Vector has
 	 * @access public
@@ -187,6 +751,64 @@ class VariantList extends Variant
 		return $this->mData->count();
 	}
 
+	/**
+	 * This method returns a new VariantList with the first occurrence of each value, in order
+	 * @access public
+	 * @name VariantList::distinct()
+	 * @return VariantList
+	 */
+	public function distinct() : VariantList
+	{
+		// Create the response list
+		$vltReturn = new VariantList();
+		// Create the set of values seen so far
+		$setSeen   = Set {};
+		// Iterate over the data
+		foreach ($this->getIterator() as $varData) {
+			// Hash the data
+			$strHash = self::hashKey($varData->getData());
+			// Check for the data
+			if ($setSeen->contains($strHash) === false) {
+				// Add the data to the set
+				$setSeen->add($strHash);
+				// Add the data to the response list
+				$vltReturn->add($varData->getData());
+			}
+		}
+		// We're done
+		return $vltReturn;
+	}
+
+	/**
+	 * This method returns a new VariantList with each value that occurs more than once, in the order they repeat
+	 * @access public
+	 * @name VariantList::duplicates()
+	 * @return VariantList
+	 */
+	public function duplicates() : VariantList
+	{
+		// Create the response list
+		$vltReturn = new VariantList();
+		// Create the occurrence counts
+		$mapSeen   = Map {};
+		// Iterate over the data
+		foreach ($this->getIterator() as $varData) {
+			// Hash the data
+			$strHash  = self::hashKey($varData->getData());
+			// Count the occurrence
+			$intCount = ($mapSeen->get($strHash) ?? 0) + 1;
+			// Set the count
+			$mapSeen->set($strHash, $intCount);
+			// Check for the first repeat
+			if ($intCount === 2) {
+				// Add the data to the response list
+				$vltReturn->add($varData->getData());
+			}
+		}
+		// We're done
+		return $vltReturn;
+	}
+
 	/**
 	 * This method is an alias of VariantList::at()
 	 * @access public
@@ -209,10 +831,148 @@ class VariantList extends Variant
 	 */
 	public function getIterator() : KeyedIterator<int, Variant>
 	{
+		// Check for lazy mode or a packed column
+		if ($this->mLazy || ($this->mColumnType !== null)) {
+			// Return the wrapping iterator
+			return $this->lazyIterator();
+		}
 		// Return the iterator
 		return $this->mData->getIterator();
 	}
 
+	/**
+	 * This method groups a VariantList<VariantMap> by one or more key columns and computes aggregates for each group in the same pass
+	 * Each group is a VariantMap holding the key columns and one entry per aggregate named like "sum(price)", a count of the "*" column counts rows
+	 * Rows are grouped by the exact type and value of their keys, the response map is keyed by the key values joined with $strGlue
+	 * Groups whose joined keys collide, such as 1 and '1', get the glue and their ordinal appended to keep them apart
+	 * @access public
+	 * @name VariantList::groupedAggregateMap()
+	 * @param HH\Vector<string> $vecKeys
+	 * @param HH\Vector<HH\Pair<Aggregate, string>> $vecAggregates [null]
+	 * @param string $strGlue [|] The string the key columns are joined with in the response map's keys
+	 * @return VariantMap
+	 */
+	public function groupedAggregateMap(Vector<string> $vecKeys, ?Vector<Pair<Aggregate, string>> $vecAggregates = null, string $strGlue = '|') : VariantMap
+	{
+		// Localize the aggregates
+		$vecAggregates = $vecAggregates ?? Vector { Pair { Aggregate::ACount, '*' } };
+		// Localize the names of the aggregates
+		$vecNames      = Vector {};
+		// Iterate over the aggregates
+		foreach ($vecAggregates->getIterator() as $parAggregate) {
+			// Add the name
+			$vecNames->add($parAggregate[0].'('.$parAggregate[1].')');
+		}
+		// Create the groups and their display keys, both keyed by the hash of the key values
+		$mapGroups   = Map {};
+		$mapDisplays = Map {};
+		// Iterate over the rows
+		foreach ($this->getIterator() as $varRow) {
+			// Make sure we have a map
+			if (($varRow instanceof VariantMap) === false) {
+				// Next row
+				continue;
+			}
+			// Collect the key values
+			$arrKeys = [];
+			// Iterate over the key columns
+			foreach ($vecKeys->getIterator() as $strKey) {
+				// Add the raw key value
+				$arrKeys[] = $varRow->at($strKey)->getData();
+			}
+			// Create the group key
+			$strGroup = '';
+			// Iterate over the key values
+			foreach ($arrKeys as $mixKey) {
+				// Append the length prefixed hash, so neither the glue nor the type of a value can make two tuples collide
+				$strHash   = self::hashKey($mixKey);
+				$strGroup .= strlen($strHash).':'.$strHash;
+			}
+			// Grab the group
+			$mapGroup = $mapGroups->get($strGroup);
+			// Check for a new group
+			if ($mapGroup === null) {
+				// Create the group
+				$mapGroup = Map {};
+				// Iterate over the key columns
+				foreach ($vecKeys->getIterator() as $intKey => $strKey) {
+					// Set the key value
+					$mapGroup->set($strKey, $arrKeys[$intKey]);
+				}
+				// Iterate over the aggregates
+				foreach ($vecAggregates->getIterator() as $intAggregate => $parAggregate) {
+					// Counts start at zero, everything else starts empty
+					$mapGroup->set($vecNames->at($intAggregate), (($parAggregate[0] === Aggregate::ACount) ? 0 : null));
+				}
+				// Set the group into the map
+				$mapGroups->set($strGroup, $mapGroup);
+				// Set the display key, containers are rendered as JSON
+				$mapDisplays->set($strGroup, implode($strGlue, array_map(($mixKey) ==> ((is_scalar($mixKey) || ($mixKey === null)) ? (string) $mixKey : json_encode($mixKey)), $arrKeys)));
+			}
+			// Iterate over the aggregates
+			foreach ($vecAggregates->getIterator() as $intAggregate => $parAggregate) {
+				// Localize the name and current value
+				$strName    = $vecNames->at($intAggregate);
+				$mixCurrent = $mapGroup->at($strName);
+				// Check for a row count
+				if (($parAggregate[0] === Aggregate::ACount) && ($parAggregate[1] === '*')) {
+					// Count the row
+					$mapGroup->set($strName, ($mixCurrent + 1));
+					// Next aggregate
+					continue;
+				}
+				// Grab the value
+				$varValue = $varRow->at($parAggregate[1]);
+				$mixValue = $varValue->getData();
+				// Skip nulls like SQL does
+				if ($mixValue === null) {
+					// Next aggregate
+					continue;
+				}
+				// Determine the aggregate
+				switch ($parAggregate[0]) {
+					case Aggregate::ACount : // count
+						$mapGroup->set($strName, ($mixCurrent + 1));
+						break;
+					case Aggregate::AMax   : // max
+						if (($mixCurrent === null) || ($mixValue > $mixCurrent)) {
+							$mapGroup->set($strName, $mixValue);
+						}
+						break;
+					case Aggregate::AMin   : // min
+						if (($mixCurrent === null) || ($mixValue < $mixCurrent)) {
+							$mapGroup->set($strName, $mixValue);
+						}
+						break;
+					case Aggregate::ASum   : // sum
+						$mapGroup->set($strName, (($mixCurrent ?? 0) + ((is_int($mixValue) || is_float($mixValue)) ? $mixValue : $varValue->toDouble())));
+						break;
+				}
+			}
+		}
+		// Create a response map
+		$mapReturn   = new VariantMap();
+		// Create the set of display keys in use
+		$setDisplays = Set {};
+		// Iterate over the groups
+		foreach ($mapGroups->getIterator() as $strGroup => $mapGroup) {
+			// Localize the display key
+			$strDisplay = $mapDisplays->at($strGroup);
+			$strUnique  = $strDisplay;
+			// Iterate until the display key is unique
+			for ($intOrdinal = 2; $setDisplays->contains($strUnique); ++$intOrdinal) {
+				// Append the ordinal
+				$strUnique = $strDisplay.$strGlue.'#'.$intOrdinal;
+			}
+			// Keep the display key
+			$setDisplays->add($strUnique);
+			// Set the group into the response map
+			$mapReturn->set($strUnique, $mapGroup);
+		}
+		// Return the response map
+		return $mapReturn;
+	}
+
 	/**
 	 * This method groups a VariantList<VariantMap> into a VariantMap<string, VariantList>> indexed by $strMapKey
 	 * @access public
@@ -222,44 +982,148 @@ class VariantList extends Variant
 	 */
 	public function groupedVariantMap(string $strMapKey) : VariantMap
 	{
-		// Create a response map
-		$mapReturn = new VariantMap();
-		// Iterate over the vector
-		foreach ($this->mData->getIterator() as $intIndex => $varValue) {
+		// Create the groups, keyed exactly so each row only hashes its key once
+		$mapGroups = Map {};
+		// Iterate over the key column
+		foreach ($this->columnIterator($strMapKey) as $intIndex => $varKey) {
 			// Check for the key in the grid
-			if ($varValue->get($strMapKey)->isEmpty() === false) {
-				// Check for a key in the map
-				if ($mapReturn->contains($varValue->get($strMapKey)) === false) {
-					// Create the key
-					$mapReturn->set($varValue->get($strMapKey)->toString(), new VariantList());
-				}
-				// Set the value
-				$mapReturn->get($varValue->get($strMapKey)->toString())->add($varValue->getData());
+			if (($varKey === null) || $varKey->isEmpty()) {
+				// Next row
+				continue;
 			}
+			// Convert the key once
+			$strGroup = $varKey->toString();
+			// Grab the group
+			$vltGroup = $mapGroups->get($strGroup);
+			// Check for a new group
+			if ($vltGroup === null) {
+				// Create the group
+				$vltGroup = new VariantList();
+				// Set the group into the map
+				$mapGroups->set($strGroup, $vltGroup);
+			}
+			// Set the value
+			$vltGroup->add($this->fetch($intIndex)->getData());
+		}
+		// Create a response map
+		$mapReturn = new VariantMap();
+		// Iterate over the groups
+		foreach ($mapGroups->getIterator() as $strGroup => $vltGroup) {
+			// Set the group into the response map
+			$mapReturn->setVariant($strGroup, $vltGroup);
 		}
 		// Return the response map
 		return $mapReturn;
 	}
 
 	/**
-	 * This method checks the vector data for duplicates
+	 * This method checks the vector data for duplicates in a single pass, values are compared loosely like in_array() unless $blnStrict is set
+	 * Loose keys are normalized so that they hash like they compare, numbers and numeric strings by their value and other strings as-is, with
+	 * numbers also checked against the leading number of other strings, booleans and nulls are checked against flags for the truthiness seen
+	 * so far, values that cannot be normalized, such as arrays and objects, are only compared to each other with in_array()
+	 * The strict check needs values to be identical in type and value
 	 * @access public
 	 * @name VariantList::hasDuplicates()
+	 * @param bool $blnStrict [false]
 	 * @return bool
 	 */
-	public function hasDuplicates() : bool
+	public function hasDuplicates(bool $blnStrict = false) : bool
 	{
-		// Create a temporary array
-		$arrTemp = [];
-		// Iterate over the data
-		foreach ($this->getIterator() as $varData) {
-			// Check for the data
-			if (in_array($varData->getData(), $arrTemp)) {
-				// We're done
+		// Create the sets of keys seen so far
+		$setSeen      = Set {};
+		$setNumbers   = Set {};
+		$setPrefixes  = Set {};
+		// Create the values that cannot be normalized
+		$arrOthers    = [];
+		// Create the flags for the truthiness seen so far, and for the booleans and nulls seen so far
+		$blnTruthy    = false;
+		$blnFalsy     = false;
+		$blnNullish   = false;
+		$blnSeenTrue  = false;
+		$blnSeenFalse = false;
+		$blnSeenNull  = false;
+		// Iterate over the stored values, raw values are read without wrapping them
+		foreach ($this->mData as $mixValue) {
+			// Unwrap a value that has been reached
+			$mixData = (($mixValue instanceof Variant) ? $mixValue->getData() : $mixValue);
+			// Check for a strict comparison
+			if ($blnStrict) {
+				// Hash the data
+				$strHash = self::hashKey($mixData);
+				// Check for the data
+				if ($setSeen->contains($strHash)) {
+					// We're done
+					return true;
+				}
+				// Add the data to the set
+				$setSeen->add($strHash);
+				// Next value
+				continue;
+			}
+			// Localize the truthiness of the data, and whether or not it equals null
+			$blnTrue = (bool) $mixData;
+			$blnNull = (is_string($mixData) ? ($mixData === '') : ($blnTrue === false));
+			// Check for a boolean or a null, which equal anything with the same truthiness
+			if (is_bool($mixData) || ($mixData === null)) {
+				// Check for a value it equals
+				if (($mixData === null) ? $blnNullish : ($blnTrue ? $blnTruthy : $blnFalsy)) {
+					// We're done
+					return true;
+				}
+				// Flag the boolean or null
+				$blnSeenTrue  = ($blnSeenTrue || ($mixData === true));
+				$blnSeenFalse = ($blnSeenFalse || ($mixData === false));
+				$blnSeenNull  = ($blnSeenNull || ($mixData === null));
+			} elseif (($blnSeenTrue && $blnTrue) || ($blnSeenFalse && ($blnTrue === false)) || ($blnSeenNull && $blnNull)) {
+				// A boolean or null seen before equals the data
 				return true;
+			} elseif (is_float($mixData) && is_nan($mixData)) {
+				// Not a number equals nothing but booleans, which the flags cover
+			} elseif (is_int($mixData) || is_float($mixData)) {
+				// Normalize the number
+				$strKey = self::looseNumberKey($mixData);
+				// Check for a number, a numeric string or a string with the same leading number
+				if ($setNumbers->contains($strKey) || $setPrefixes->contains($strKey)) {
+					// We're done
+					return true;
+				}
+				// Add the number, strings compare to it by their leading number
+				$setNumbers->add($strKey);
+				$setSeen->add('b'.$strKey);
+			} elseif (is_string($mixData) && is_numeric($mixData)) {
+				// Normalize the numeric string by its value
+				$strKey = self::looseNumberKey($mixData + 0);
+				// Check for a number or numeric string with the same value
+				if ($setNumbers->contains($strKey)) {
+					// We're done
+					return true;
+				}
+				// Add the numeric string
+				$setNumbers->add($strKey);
+			} elseif (is_string($mixData)) {
+				// Normalize the leading number, which is what a number compares the string to
+				$strPrefix = self::looseNumberKey((float) $mixData);
+				// Check for the same string, or a number equal to its leading number
+				if ($setSeen->contains('s'.$mixData) || $setSeen->contains('b'.$strPrefix)) {
+					// We're done
+					return true;
+				}
+				// Add the string and its leading number
+				$setSeen->add('s'.$mixData);
+				$setPrefixes->add($strPrefix);
+			} else {
+				// Check for a value that cannot be normalized
+				if (in_array($mixData, $arrOthers)) {
+					// We're done
+					return true;
+				}
+				// Add the value
+				$arrOthers[] = $mixData;
 			}
-			// Add the data to the array
-			array_push($arrTemp, $varData->getData());
+			// Flag the truthiness of the data
+			$blnTruthy  = ($blnTruthy || $blnTrue);
+			$blnFalsy   = ($blnFalsy || ($blnTrue === false));
+			$blnNullish = ($blnNullish || $blnNull);
 		}
 		// We're done
 		return false;
@@ -275,23 +1139,25 @@ class VariantList extends Variant
 	 */
 	public function implode(string $strDelimiter = ',', bool $blnForMySQL = false) : string
 	{
-		// Create a temporary vector
-		$vecTemp = Vector {};
+		// Create the buffer
+		$strBuffer = '';
 		// Iterate over the data
 		foreach ($this->getIterator() as $intIndex => $varValue) {
-			// Check the flag
-			if ($blnForMySQL) {
-				// Set the data
-				$vecTemp
-					->add($varValue->toMySqlString());
-			} else {
-				// Set the data
-				$vecTemp
-					->add($varValue->toString());
+			// Check for a preceding element
+			if ($intIndex > 0) {
+				// Append the delimiter
+				$strBuffer .= $strDelimiter;
 			}
+			// Append the data
+			$strBuffer .= ($blnForMySQL ? $varValue->toMySqlString() : $varValue->toString());
+		}
+		// Check for counting
+		if (VariantStats::enabled()) {
+			// Count the bytes
+			VariantStats::increment('bytes.implode', strlen($strBuffer));
 		}
-		// Return the imploded vector
-		return implode($strDelimiter, $vecTemp->toArray());
+		// Return the imploded string
+		return $strBuffer;
 	}
 
 	/**
@@ -304,16 +1170,71 @@ class VariantList extends Variant
 	 */
 	public function implodeCallback(string $strDelimiter = ',', callable $fnCallback) : string
 	{
-		// Localize the data
-		$vecTemp = Vector {};
+		// Create the buffer
+		$strBuffer = '';
+		// Iterate over the data
+		foreach ($this->getIterator() as $intIndex => $varValue) {
+			// Check for a preceding element
+			if ($intIndex > 0) {
+				// Append the delimiter
+				$strBuffer .= $strDelimiter;
+			}
+			// Append the data after executing the callback
+			$strBuffer .= $fnCallback($varValue);
+		}
+		// Return the imploded string
+		return $strBuffer;
+	}
+
+	/**
+	 * This method implodes the vector into a sink, which is called with chunks of at least $intChunkSize bytes and once more with the remainder
+	 * @access public
+	 * @name VariantList::implodeTo()
+	 * @param callable $fnSink
+	 * @param string $strDelimiter [,]
+	 * @param bool $blnForMySQL [false]
+	 * @param int $intChunkSize [65536]
+	 * @return int The number of bytes sent to the sink
+	 */
+	public function implodeTo(callable $fnSink, string $strDelimiter = ',', bool $blnForMySQL = false, int $intChunkSize = 65536) : int
+	{
+		// Create the buffer
+		$strBuffer = '';
+		// Create the byte counter
+		$intBytes  = 0;
 		// Iterate over the data
 		foreach ($this->getIterator() as $intIndex => $varValue) {
-			// Reset the data after executing the callback
-			$vecTemp
-				->add(call_user_func_array($fnCallback, [$varValue]));
+			// Check for a preceding element
+			if ($intIndex > 0) {
+				// Append the delimiter
+				$strBuffer .= $strDelimiter;
+			}
+			// Append the data
+			$strBuffer .= ($blnForMySQL ? $varValue->toMySqlString() : $varValue->toString());
+			// Check the size of the buffer
+			if (strlen($strBuffer) >= $intChunkSize) {
+				// Send the chunk to the sink
+				$fnSink($strBuffer);
+				// Count the bytes
+				$intBytes += strlen($strBuffer);
+				// Reset the buffer
+				$strBuffer = '';
+			}
 		}
-		// Return the imploded vector
-		return implode($strDelimiter, $vecTemp->toArray());
+		// Check for a remainder
+		if ($strBuffer !== '') {
+			// Send the remainder to the sink
+			$fnSink($strBuffer);
+			// Count the bytes
+			$intBytes += strlen($strBuffer);
+		}
+		// Check for counting
+		if (VariantStats::enabled()) {
+			// Count the bytes
+			VariantStats::increment('bytes.implode', $intBytes);
+		}
+		// We're done
+		return $intBytes;
 	}
 
 	/**
@@ -328,6 +1249,19 @@ class VariantList extends Variant
 		return $this->mData->isEmpty();
 	}
 
+	/**
+	 * This method extracts the values at $strKey from a VariantList<VariantMap> into a new VariantList in their original type
+	 * @access public
+	 * @name VariantList::pluck()
+	 * @param string $strKey
+	 * @return VariantList
+	 */
+	public function pluck(string $strKey) : VariantList
+	{
+		// Return the column, the values are only wrapped when they are reached
+		return self::Factory($this->column($strKey), true);
+	}
+
 	/**
 	 * This method removes the last element in the vector and returns it
 	 * @access public
@@ -336,8 +1270,12 @@ class VariantList extends Variant
 	 */
 	public function pop() : Variant
 	{
-		// Return the popped value
-		return $this->mData->pop();
+		// Pop the value
+		$mixValue = $this->mData->pop();
+		// The data has changed
+		$this->invalidate();
+		// Return the popped value, wrapping it if it was never reached
+		return (($mixValue instanceof Variant) ? $mixValue : Variant::Factory($mixValue, true));
 	}
 
 	/**
@@ -349,7 +1287,7 @@ class VariantList extends Variant
 	public function popReal() : mixed
 	{
 		// Return the actual value of the popped element
-		return $this->mData->pop()->getData();
+		return $this->pop()->getData();
 	}
 
 	/**
@@ -363,6 +1301,8 @@ class VariantList extends Variant
 	{
 		// Remove the key
 		$this->mData->removeKey($intKey);
+		// The data has changed
+		$this->invalidate();
 		// We're done
 		return $this;
 	}
@@ -404,8 +1344,17 @@ class VariantList extends Variant
 	 */
 	public function resize(int $intSize, mixed $mixDefaultValue = null) : void
 	{
+		// Check for new indices that do not fit a packed column
+		if (($intSize > $this->mData->count()) && (($this->mColumnType === null) || (self::columnTypeOf($mixDefaultValue) !== $this->mColumnType))) {
+			// Leave the packed column, if any
+			$this->leaveColumn();
+			// The new indices hold the raw default value, so wrap them on first access
+			$this->mLazy = true;
+		}
 		// Resize the vector
 		$this->mData->resize($intSize, $mixDefaultValue);
+		// The data has changed
+		$this->invalidate();
 	}
 
 	/**
@@ -418,6 +1367,8 @@ class VariantList extends Variant
 	{
 		// Reverse the keys
 		$this->mData->reverse();
+		// The data has changed
+		$this->invalidate();
 	}
 
 	/**
@@ -443,9 +1394,27 @@ class VariantList extends Variant
 	 */
 	public function set(int $intKey, mixed $mixValue) : VariantList
 	{
+		// Check for a value that fits the packed column
+		if (($this->mColumnType !== null) && (self::columnTypeOf($mixValue) === $this->mColumnType)) {
+			// Set the raw value
+			$this->mData
+				->set($intKey, $mixValue);
+			// The data has changed
+			$this->invalidate();
+			// We're done
+			return $this;
+		}
+		// Leave the packed column, if any
+		$this->leaveColumn();
+		// Wrap the value
+		$varValue = Variant::Factory($mixValue);
 		// Set the data into the instance
 		$this->mData
-			->set($intKey, Variant::Factory($mixValue));
+			->set($intKey, $varValue);
+		// A shared Variant is swapped for a private copy when it is reached, so iteration has to go through fetch() from now on
+		$this->mLazy = ($this->mLazy || $varValue->mInterned);
+		// The data has changed
+		$this->invalidate();
 		// We're done
 		return $this;
 	}
@@ -460,6 +1429,8 @@ class VariantList extends Variant
 	{
 		// Shuffle the data
 		$this->mData->shuffle();
+		// The data has changed
+		$this->invalidate();
 	}
 
 	/**
@@ -474,6 +1445,8 @@ class VariantList extends Variant
 	{
 		// Splice the data
 		$this->mData->splice($intOffset, $intLength);
+		// The data has changed
+		$this->invalidate();
 	}
 
 	//////////////////////////////////////////////////////////////////////////////
@@ -481,7 +1454,7 @@ class VariantList extends Variant
 	////////////////////////////////////////////////////////////////////////////
 
 	/**
-	 * This method returns the data as a sequential array with the values as their original type
+	 * This method returns the data as a sequential array with the values as their original type, raw values are read as-is without wrapping them
 	 * @access public
 	 * @name VariantList::toArray()
 	 * @return array<mixed>
@@ -490,10 +1463,10 @@ class VariantList extends Variant
 	{
 		// Create the response array
 		$arrData = [];
-		// Iterate over the data
-		foreach ($this->mData->getIterator() as $strKey => $varValue) {
-			// Add the key to the response array
-			$arrData[$strKey] = $varValue->getData();
+		// Iterate over the stored values
+		foreach ($this->mData as $intIndex => $mixValue) {
+			// Add the value to the response array, unwrapping the values that have been reached
+			$arrData[$intIndex] = (($mixValue instanceof Variant) ? $mixValue->getData() : $mixValue);
 		}
 		// We're done
 		return $arrData;
@@ -507,16 +1480,20 @@ class VariantList extends Variant
 	 */
 	public function toBoolList() : Vector<bool>
 	{
-		// Create the temporary vector
-		$vecTemp = Vector {};
-		// Iterate over the current Vector
-		foreach ($this->getIterator() as $intIndex => $varItem) {
-			// Add the item to the temporary vector
-			$vecTemp
-				->add($varItem->toBool());
-		}
-		// Return the vector
-		return $vecTemp;
+		// Return the bulk conversion
+		return $this->convertAll(Type::VBoolean);
+	}
+
+	/**
+	 * This method converts the VariantList to a Vector of floats, PHP floats are doubles so this is the VDouble conversion
+	 * @access public
+	 * @name VariantList::toFloatList()
+	 * @return HH\Vector<float>
+	 */
+	public function toFloatList() : Vector<float>
+	{
+		// Return the bulk conversion
+		return $this->convertAll(Type::VDouble);
 	}
 
 	/**
@@ -527,16 +1504,53 @@ class VariantList extends Variant
 	 */
 	public function toIntList() : Vector<int>
 	{
-		// Create the temporary vector
-		$vecTemp = Vector {};
-		// Iterate over the current Vector
-		foreach ($this->getIterator() as $varItem) {
-			// Add the item to the temporary vector
-			$vecTemp
-				->add($varItem->toInt());
+		// Return the bulk conversion
+		return $this->convertAll(Type::VInteger);
+	}
+
+	/**
+	 * This method converts the VariantList to a Vector of JSON strings, one per value, encoded from the raw values with a single pass
+	 * Scalars are encoded as themselves, unlike Variant::toJson() which only encodes containers and returns an empty object for anything else
+	 * Values that are already JSON objects are passed through as-is, the way Variant::convert() passes VJson through, instead of being encoded again
+	 * @access public
+	 * @name VariantList::toJsonList()
+	 * @return HH\Vector<string>
+	 */
+	public function toJsonList() : Vector<string>
+	{
+		// Check for a packed column that cannot hold JSON
+		if (($this->mColumnType !== null) && ($this->mColumnType !== Type::VString)) {
+			// Encode the column
+			return new Vector(array_map('json_encode', $this->mData->toArray()));
+		}
+		// Create the response vector
+		$vecReturn = Vector {};
+		// Reserve the indices
+		$vecReturn->reserve($this->mData->count());
+		// Iterate over the raw values
+		foreach ($this->mData->getIterator() as $mixValue) {
+			// Check for a raw string that may be a JSON object
+			if (is_string($mixValue) && self::looksLikeJson($mixValue)) {
+				// Wrap the string so it is decoded once to be sure
+				$mixValue = new Variant($mixValue);
+			}
+			// Check the value
+			if (($mixValue instanceof Variant) && ($mixValue->getType() === Type::VJson)) {
+				// Pass the JSON through
+				$vecReturn->add($mixValue->getData());
+			} elseif (($mixValue instanceof VariantMap) || ($mixValue instanceof VariantList)) {
+				// Encode the container, its values are unwrapped recursively
+				$vecReturn->add(json_encode($mixValue->toArray()));
+			} elseif ($mixValue instanceof Variant) {
+				// Encode the data
+				$vecReturn->add(json_encode($mixValue->getData()));
+			} else {
+				// Encode the raw value
+				$vecReturn->add(json_encode($mixValue));
+			}
 		}
-		// Return the vector
-		return $vecTemp;
+		// We're done
+		return $vecReturn;
 	}
 
 	/**
@@ -563,6 +1577,36 @@ class VariantList extends Variant
 		return new Vector($this->toKeysArray());
 	}
 
+	/**
+	 * This method converts the VariantList to escaped MySQL IN-lists, each one capped at $intMaxBytes
+	 * @access public
+	 * @name VariantList::toMySqlInLists()
+	 * @param int $intMaxBytes [1048576]
+	 * @return HH\Vector<string>
+	 * @see VariantSqlBuilder::inLists()
+	 */
+	public function toMySqlInLists(int $intMaxBytes = 1048576) : Vector<string>
+	{
+		// Return the IN-lists
+		return VariantSqlBuilder::Factory($intMaxBytes)->inLists($this);
+	}
+
+	/**
+	 * This method converts a VariantList<VariantMap> to multi-row MySQL INSERT statements, each one capped at $intMaxBytes
+	 * @access public
+	 * @name VariantList::toMySqlInserts()
+	 * @param string $strTable
+	 * @param HH\Vector<string> $vecColumns
+	 * @param int $intMaxBytes [1048576]
+	 * @return HH\Vector<string>
+	 * @see VariantSqlBuilder::insertStatements()
+	 */
+	public function toMySqlInserts(string $strTable, Vector<string> $vecColumns, int $intMaxBytes = 1048576) : Vector<string>
+	{
+		// Return the statements
+		return VariantSqlBuilder::Factory($intMaxBytes)->insertStatements($strTable, $vecColumns, $this);
+	}
+
 	/**
 	 * This method converts the VariantList to a Vector of strings
 	 * @access public
@@ -571,16 +1615,8 @@ class VariantList extends Variant
 	 */
 	public function toStringList() : Vector<string>
 	{
-		// Create the temporary vector
-		$vecTemp = Vector {};
-		// Iterate over the current Vector
-		foreach ($this->getIterator() as $varItem) {
-			// Add the item to the temporary vector
-			$vecTemp
-				->add($varItem->toString());
-		}
-		// Return the vector
-		return $vecTemp;
+		// Return the bulk conversion
+		return $this->convertAll(Type::VString);
 	}
 
 	/**
@@ -589,14 +1625,12 @@ class VariantList extends Variant
 	 * @name VariantList::toTargetKeyList()
 	 * @param string $strKey
 	 * @return VariantList
+	 * @see VariantList::pluck()
 	 */
 	public function toTargetKeyList(string $strKey) : VariantList
 	{
-		// Return the vector
-		return self::Factory(explode(',', $this->implodeCallback(',', function(VariantMap $varMapData) use($strKey) {
-			// Return the target key
-			return $varMapData->get($strKey)->getData();
-		})));
+		// Return the plucked values
+		return $this->pluck($strKey);
 	}
 
 	/**
@@ -607,6 +1641,8 @@ class VariantList extends Variant
 	 */
 	public function toValuesArray() : array<mixed>
 	{
+		// Make sure every value is wrapped
+		$this->materialize();
 		// Return the values array
 		return array_filter($this->mData->toValuesArray(), function(Variant $varValue) {
 			// Return the real value
@@ -634,10 +1670,25 @@ class VariantList extends Variant
 	 */
 	public function toVariantArray() : array<Variant>
 	{
+		// Make sure every value is wrapped
+		$this->materialize();
 		// Return the data
 		return $this->mData->toArray();
 	}
 
+	/**
+	 * This method converts a VariantList<VariantMap> to a VariantTable, which keeps each key once and each column as raw values
+	 * @access public
+	 * @name VariantList::toVariantTable()
+	 * @return VariantTable
+	 * @see VariantTable::fromVariantList()
+	 */
+	public function toVariantTable() : VariantTable
+	{
+		// Return the table
+		return VariantTable::fromVariantList($this);
+	}
+
 	/**
 	 * This method returns the Vector's values as an array of Variants
 	 * @access public
@@ -646,6 +1697,8 @@ class VariantList extends Variant
 	 */
 	public function toVariantValuesArray() : array<Variant>
 	{
+		// Make sure every value is wrapped
+		$this->materialize();
 		// Return the values array
 		return $this->mData->toValuesArray();
 	}
@@ -667,22 +1720,54 @@ class VariantList extends Variant
 	////////////////////////////////////////////////////////////////////////////
 
 	/**
-	 * This method retuns the data in its original type
+	 * This method retuns the data in its original type, served from the cached view
+	 * The vector itself is a copy that can be changed, the containers below it are their own cached immutable views
 	 * @access public
 	 * @name VariantList::getData()
 	 * @return HH\Vector<mixed>
 	 */
 	public function getData() : Vector<mixed>
 	{
+		// Return a copy of the view
+		return $this->getImmutableData()->toVector();
+	}
+
+	/**
+	 * This method returns the data as an immutable view, it is cached until this list or anything below it changes
+	 * Raw values in lazy mode are read as-is, so building the view never wraps them
+	 * @access public
+	 * @name VariantList::getImmutableData()
+	 * @return HH\ImmVector<mixed>
+	 */
+	public function getImmutableData() : ImmVector<mixed>
+	{
+		// Check for a cached view nothing has changed under since it was built
+		if (($this->mDataCache !== null) && ($this->revision() <= $this->mDataRevision)) {
+			// We're done
+			return $this->mDataCache;
+		}
+		// Check for a packed column
+		if ($this->mColumnType !== null) {
+			// The column already holds the raw values, cache a copy of it
+			$this->mDataCache    = $this->mData->toImmVector();
+			$this->mDataRevision = self::$mRevisionCounter;
+			// We're done
+			return $this->mDataCache;
+		}
 		// Create the response map
 		$vecData = Vector {};
-		// Iterate over the data map
-		foreach ($this->mData->getIterator() as $varValue) {
-			// Reset the data into the new map
+		// Reserve the indices
+		$vecData->reserve($this->mData->count());
+		// Iterate over the stored values
+		foreach ($this->mData as $mixValue) {
+			// Add the view of the value, raw values are used as-is
 			$vecData
-				->add($varValue->getData());
+				->add(($mixValue instanceof Variant) ? $mixValue->getImmutableData() : $mixValue);
 		}
-		// Return the data
-		return $vecData;
+		// Cache the view with the change count it is current as of
+		$this->mDataCache    = $vecData->toImmVector();
+		$this->mDataRevision = self::$mRevisionCounter;
+		// Return the view
+		return $this->mDataCache;
 	}
 }
@@ -16,6 +16,62 @@ class VariantMap extends Variant
 	 */
 	protected Map<string, Variant> $mData = Map {};
 
+	/**
+	 * This property caches the immutable view built by getImmutableData(), null while it is out of date
+	 * @access protected
+	 * @name VariantMap::$mDataCache
+	 * @var HH\ImmMap<string, mixed>
+	 */
+	protected ?ImmMap<string, mixed> $mDataCache = null;
+
+	/**
+	 * This property contains the change stamp the cached view is current as of
+	 * @access protected
+	 * @name VariantMap::$mDataRevision
+	 * @var int
+	 */
+	protected int $mDataRevision          = 0;
+
+	/**
+	 * This property tells the instance whether or not two keys in the map fold to the same lowercase key
+	 * @access protected
+	 * @name VariantMap::$mKeyCollision
+	 * @var bool
+	 */
+	protected bool $mKeyCollision         = false;
+
+	/**
+	 * This property maps each lowercase key to the real key it was first set with, null until a case-insensitive lookup needs it
+	 * @access protected
+	 * @name VariantMap::$mKeyIndex
+	 * @var HH\Map<string, string>
+	 */
+	protected ?Map<string, string> $mKeyIndex = null;
+
+	/**
+	 * This property tells the instance whether or not the values in the map may still be raw or interned, they are wrapped or copied on first access
+	 * @access protected
+	 * @name VariantMap::$mLazy
+	 * @var bool
+	 */
+	protected bool $mLazy                 = false;
+
+	/**
+	 * This property contains the newest change stamp found in the map and everything below it the last time it was looked for
+	 * @access protected
+	 * @name VariantMap::$mTreeRevision
+	 * @var int
+	 */
+	protected int $mTreeRevision          = 0;
+
+	/**
+	 * This property contains the change count VariantMap::$mTreeRevision was taken at, it stays good until anything changes again
+	 * @access protected
+	 * @name VariantMap::$mTreeRevisionAt
+	 * @var int
+	 */
+	protected int $mTreeRevisionAt        = -1;
+
 	//////////////////////////////////////////////////////////////////////////////
 	/// Constructor /////////////////////////////////////////////////////////////
 	////////////////////////////////////////////////////////////////////////////
@@ -25,14 +81,22 @@ class VariantMap extends Variant
 	 * @access public
 	 * @name VariantMap::__construct()
 	 * @param KeyedTraversable<Tk, Tv> $ktsSource [null]
+	 * @param bool $blnLazy [false]
 	 * @return void
 	 */
-	public function __construct(?KeyedTraversable<Tk, Tv> $ktsSource = null) : Variant
+	public function __construct(?KeyedTraversable<Tk, Tv> $ktsSource = null, bool $blnLazy = false) : Variant
 	{
 		// Check for data
 		if (is_null($ktsSource) === false) {
 			// Create a new map out of the
 			$this->mData = new Map($ktsSource);
+			// Check for lazy wrapping
+			if ($blnLazy) {
+				// Keep the raw values until they are reached
+				$this->mLazy = true;
+				// We're done
+				return $this;
+			}
 			// Iterate over the map
 			foreach ($this->mData->getIterator() as $strKey => $mixValue) {
 				// Reset the data
@@ -55,18 +119,19 @@ class VariantMap extends Variant
 	 * @access public
 	 * @name VariantMap::Factory()
 	 * @param mixed $tvsSource
+	 * @param bool $blnLazy [false]
 	 * @return VariantMap
 	 * @static
 	 */
-	public static function Factory(mixed $tvsSource) : VariantMap
+	public static function Factory(mixed $tvsSource, bool $blnLazy = false) : VariantMap
 	{
 		// Check the type
-		if (!($tvsSource instanceof HH\Map) && is_object($tvsSource)) {
+		if (!($tvsSource instanceof HH\ConstMap) && is_object($tvsSource)) {
 			// Return the new instance
-			return self::fromObject($tvsSource);
+			return self::fromObject($tvsSource, $blnLazy);
 		}
 		// Return the new instance
-		return new self($tvsSource);
+		return new self($tvsSource, $blnLazy);
 	}
 
 	//////////////////////////////////////////////////////////////////////////////
@@ -78,13 +143,14 @@ class VariantMap extends Variant
 	 * @access public
 	 * @name VariantMap::fromArray()
 	 * @param array<string, mixed> $arrSource
+	 * @param bool $blnLazy [false]
 	 * @return VariantMap
 	 * @static
 	 */
-	public static function fromArray(array<string, mixed> $arrSource) : VariantMap
+	public static function fromArray(array<string, mixed> $arrSource, bool $blnLazy = false) : VariantMap
 	{
 		// Return the new instance
-		return new self($arrSource);
+		return new self($arrSource, $blnLazy);
 	}
 
 	/**
@@ -92,13 +158,14 @@ class VariantMap extends Variant
 	 * @access public
 	 * @name VariantMap::fromMap()
 	 * @param HH\Map<string, mixed> $mapSource
+	 * @param bool $blnLazy [false]
 	 * @return VariantMap
 	 * @static
 	 */
-	public static function fromMap(Map<string, mixed> $mapSource) : VariantMap
+	public static function fromMap(Map<string, mixed> $mapSource, bool $blnLazy = false) : VariantMap
 	{
 		// Return the new instance
-		return new self($mapSource);
+		return new self($mapSource, $blnLazy);
 	}
 
 	/**
@@ -106,10 +173,11 @@ class VariantMap extends Variant
 	 * @access public
 	 * @name VariantMap::fromObject()
 	 * @param object $objSource
+	 * @param bool $blnLazy [false]
 	 * @return VariantMap
 	 * @static
 	 */
-	public static function fromObject(object $objSource) : VariantMap
+	public static function fromObject(object $objSource, bool $blnLazy = false) : VariantMap
 	{
 		// Create the array placeholder
 		$arrSource = [];
@@ -119,7 +187,159 @@ class VariantMap extends Variant
 			$arrSource[$strProperty] = $mixValue;
 		}
 		// Return the new instance
-		return new self($arrSource);
+		return new self($arrSource, $blnLazy);
+	}
+
+	//////////////////////////////////////////////////////////////////////////////
+	/// Protected Methods ///////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////
+
+	/**
+	 * This method walks the stored entries without wrapping them, a value is its Variant once it has been reached and raw until then
+	 * @access protected
+	 * @name VariantMap::entryIterator()
+	 * @return KeyedIterator<string, mixed>
+	 */
+	protected function entryIterator() : KeyedIterator<string, mixed>
+	{
+		// Return the iterator over the stored entries
+		return $this->mData->getIterator();
+	}
+
+	/**
+	 * This method returns the Variant stored at an exact key, wrapping a raw value the first time it is reached
+	 * @access protected
+	 * @name VariantMap::fetch()
+	 * @param string $strRealKey
+	 * @return Variant
+	 */
+	protected function fetch(string $strRealKey) : Variant
+	{
+		// Grab the value
+		$mixValue = $this->mData->at($strRealKey);
+		// Check for an existing Variant that is not shared
+		if (($mixValue instanceof Variant) && ($mixValue->mInterned === false)) {
+			// We're done
+			return $mixValue;
+		}
+		// Wrap the value, its children stay lazy as well, and swap a shared Variant for a private copy so changes to it stay in this map
+		$varValue = (($mixValue instanceof Variant) ? $mixValue : Variant::Factory($mixValue, true))->unshare();
+		// Keep the wrapped value for the next access
+		$this->mData->set($strRealKey, $varValue);
+		// We're done
+		return $varValue;
+	}
+
+	/**
+	 * This method adds a real key to the case-insensitive index
+	 * @access protected
+	 * @name VariantMap::indexKey()
+	 * @param string $strRealKey
+	 * @return void
+	 */
+	protected function indexKey(string $strRealKey) : void
+	{
+		// Fold the key
+		$strFoldedKey = strtolower($strRealKey);
+		// Check for a key that already folds the same way
+		if ($this->mKeyIndex->contains($strFoldedKey)) {
+			// The first key wins, just remember that there was a collision
+			$this->mKeyCollision = true;
+		} else {
+			// Set the key into the index
+			$this->mKeyIndex->set($strFoldedKey, $strRealKey);
+		}
+	}
+
+	/**
+	 * This method returns the case-insensitive index, building it from the keys the first time it is needed
+	 * @access protected
+	 * @name VariantMap::keyIndex()
+	 * @return HH\Map<string, string>
+	 */
+	protected function keyIndex() : Map<string, string>
+	{
+		// Check for an index
+		if ($this->mKeyIndex === null) {
+			// Create the index
+			$this->mKeyIndex     = Map {};
+			$this->mKeyCollision = false;
+			// Iterate over the keys
+			foreach ($this->mData->toKeysArray() as $strRealKey) {
+				// Index the key
+				$this->indexKey($strRealKey);
+			}
+		}
+		// Return the index
+		return $this->mKeyIndex;
+	}
+
+	/**
+	 * This method walks the map and wraps each raw value as the iteration reaches it
+	 * @access protected
+	 * @name VariantMap::lazyIterator()
+	 * @return KeyedIterator<string, Variant>
+	 */
+	protected function lazyIterator() : KeyedIterator<string, Variant>
+	{
+		// Iterate over a snapshot of the keys, the map is written to as values are wrapped
+		foreach ($this->mData->toKeysArray() as $strKey) {
+			// Yield the wrapped value
+			yield $strKey => $this->fetch($strKey);
+		}
+	}
+
+	/**
+	 * This method wraps every raw value that is left and turns lazy mode off
+	 * @access protected
+	 * @name VariantMap::materialize()
+	 * @return void
+	 */
+	protected function materialize() : void
+	{
+		// Check for lazy mode
+		if ($this->mLazy === false) {
+			// We're done
+			return;
+		}
+		// Iterate over the keys
+		foreach ($this->mData->toKeysArray() as $strKey) {
+			// Wrap the value
+			$this->fetch($strKey);
+		}
+		// Every value is wrapped now
+		$this->mLazy = false;
+	}
+
+	/**
+	 * This method returns the newest change stamp of the map and every wrapped value below it, raw values never change in place
+	 * The walk is only made once per change anywhere, until then the stamp it found is returned as-is
+	 * @access protected
+	 * @name VariantMap::revision()
+	 * @return int
+	 */
+	protected function revision() : int
+	{
+		// Check for a stamp taken since the last change
+		if ($this->mTreeRevisionAt === self::$mRevisionCounter) {
+			// We're done
+			return $this->mTreeRevision;
+		}
+		// Start with the stamp of the map itself
+		$intRevision = $this->mRevision;
+		// Iterate over the values
+		foreach ($this->mData as $mixValue) {
+			// Check for a wrapped value
+			if ($mixValue instanceof Variant) {
+				// Keep the newest stamp
+				$intRevision = max($intRevision, $mixValue->revision());
+			}
+		}
+		// Keep the stamp until the next change
+		$this->mTreeRevision   = $intRevision;
+		$this->mTreeRevisionAt = self::$mRevisionCounter;
+		// We're done
+		return $intRevision;
 	}
 
 	//////////////////////////////////////////////////////////////////////////////
@@ -138,7 +358,7 @@ class VariantMap extends Variant
 		// Check for the key
 		if (($strRealKey = $this->search($strKey)) !== null) {
 			// Return the data
-			return $this->mData->get($strRealKey);
+			return $this->fetch($strRealKey);
 		}
 		// Return an empty variant
 		return Variant::Factory(null);
@@ -153,7 +373,12 @@ class VariantMap extends Variant
 	public function clear() : VariantMap
 	{
 		// Reset the data, don't use the built-in clear() as it clears all back references as well
-		$this->mData = new VariantMap();
+		$this->mData         = Map {};
+		$this->mKeyIndex     = null;
+		$this->mKeyCollision = false;
+		$this->mLazy         = false;
+		// The data has changed
+		$this->invalidate();
 		// We're done
 		return $this;
 	}
@@ -167,13 +392,8 @@ class VariantMap extends Variant
 	 */
 	public function contains(string $strKey) : bool
 	{
-		// Run the built-in first
-		if ($this->mData->contains($strKey)) {
-			// We're done
-			return true;
-		}
-		// Now search the keys using case insensitivity
-		return in_array(strtolower($strKey), array_filter($this->toKeysArray(), 'strtolower'));
+		// Return the search status
+		return ($this->search($strKey) !== null);
 	}
 
 	/**
@@ -190,6 +410,18 @@ class VariantMap extends Variant
 		return $this->contains($strKey);
 	}
 
+	/**
+	 * This method returns the number of keys the Map has, raw values in lazy mode are counted without wrapping them
+	 * @access public
+	 * @name VariantMap::count()
+	 * @return int
+	 */
+	public function count() : int
+	{
+		// Return the size of the VariantMap
+		return $this->mData->count();
+	}
+
 	/**
 	 * This method is an alias of VariantMap::at()
 	 * @access public
@@ -212,6 +444,11 @@ class VariantMap extends Variant
 	 */
 	public function getIterator() : KeyedIterator<string, Variant>
 	{
+		// Check for lazy mode
+		if ($this->mLazy) {
+			// Return the wrapping iterator
+			return $this->lazyIterator();
+		}
 		// Return the iterator
 		return $this->mData->getIterator();
 	}
@@ -225,8 +462,21 @@ class VariantMap extends Variant
 	 */
 	public function remove(string $strKey) : VariantMap
 	{
+		// Check for an index and the key
+		if (($this->mKeyIndex !== null) && $this->mData->contains($strKey)) {
+			// Check for another key that folds the same way
+			if ($this->mKeyCollision) {
+				// Drop the index, it gets rebuilt on the next case-insensitive lookup
+				$this->mKeyIndex = null;
+			} else {
+				// Remove the key from the index
+				$this->mKeyIndex->remove(strtolower($strKey));
+			}
+		}
 		// Remove the key
 		$this->mData->remove($strKey);
+		// The data has changed
+		$this->invalidate();
 		// We're done
 		return $this;
 	}
@@ -259,16 +509,13 @@ class VariantMap extends Variant
 			// We're done
 			return $strKey;
 		}
-		// Iterate over the keys
-		foreach ($this->toKeysArray() as $strRealKey) {
-			// Check the key
-			if (strtolower($strKey) == strtolower($strRealKey)) {
-				// We're done
-				return $strRealKey;
-			}
+		// Check for counting
+		if (VariantStats::enabled()) {
+			// Count the case-insensitive fallback
+			VariantStats::increment('search.fallback');
 		}
-		// We're done, no key
-		return null;
+		// Return the real key from the case-insensitive index, null if there isn't one
+		return $this->keyIndex()->get(strtolower($strKey));
 	}
 
 	/**
@@ -281,9 +528,46 @@ class VariantMap extends Variant
 	 */
 	public function set(string $strKey, mixed $mixValue) : VariantMap
 	{
+		// Check for an index and a new key
+		if (($this->mKeyIndex !== null) && ($this->mData->contains($strKey) === false)) {
+			// Index the key
+			$this->indexKey($strKey);
+		}
+		// Wrap the value
+		$varValue = Variant::Factory($mixValue);
 		// Set the data into the instance
 		$this->mData
-			->set($strKey, Variant::Factory($mixValue));
+			->set($strKey, $varValue);
+		// A shared Variant is swapped for a private copy when it is reached, so iteration has to go through fetch() from now on
+		$this->mLazy = ($this->mLazy || $varValue->mInterned);
+		// The data has changed
+		$this->invalidate();
+		// We're done
+		return $this;
+	}
+
+	/**
+	 * This method sets an existing Variant into the instance without copying it
+	 * @access public
+	 * @name VariantMap::setVariant()
+	 * @param string $strKey
+	 * @param Variant $varValue
+	 * @return VariantMap $this
+	 */
+	public function setVariant(string $strKey, Variant $varValue) : VariantMap
+	{
+		// Check for an index and a new key
+		if (($this->mKeyIndex !== null) && ($this->mData->contains($strKey) === false)) {
+			// Index the key
+			$this->indexKey($strKey);
+		}
+		// Set the Variant into the instance
+		$this->mData
+			->set($strKey, $varValue);
+		// A shared Variant is swapped for a private copy when it is reached, so iteration has to go through fetch() from now on
+		$this->mLazy = ($this->mLazy || $varValue->mInterned);
+		// The data has changed
+		$this->invalidate();
 		// We're done
 		return $this;
 	}
@@ -293,7 +577,7 @@ class VariantMap extends Variant
 	////////////////////////////////////////////////////////////////////////////
 
 	/**
-	 * This method returns the data as an associative array with the values as their original type
+	 * This method returns the data as an associative array with the values as their original type, raw values in lazy mode are read as-is without wrapping them
 	 * @access public
 	 * @name VariantMap::toArray()
 	 * @return array<string, mixed>
@@ -302,10 +586,10 @@ class VariantMap extends Variant
 	{
 		// Create the response array
 		$arrData = [];
-		// Iterate over the data
-		foreach ($this->mData->getIterator() as $strKey => $varValue) {
-			// Add the key to the response array
-			$arrData[$strKey] = $varValue->getData();
+		// Iterate over the stored entries
+		foreach ($this->entryIterator() as $strKey => $mixValue) {
+			// Add the key to the response array, unwrapping the values that have been reached
+			$arrData[$strKey] = (($mixValue instanceof Variant) ? $mixValue->getData() : $mixValue);
 		}
 		// We're done
 		return $arrData;
@@ -343,6 +627,8 @@ class VariantMap extends Variant
 	 */
 	public function toValuesArray() : array<mixed>
 	{
+		// Make sure every value is wrapped
+		$this->materialize();
 		// Return the values array
 		return array_filter($this->mData->toValuesArray(), function(Variant $varValue) {
 			// Return the real value
@@ -370,6 +656,8 @@ class VariantMap extends Variant
 	 */
 	public function toVariantArray() : array<string, Variant>
 	{
+		// Make sure every value is wrapped
+		$this->materialize();
 		// Return the data
 		return $this->mData->toArray();
 	}
@@ -382,6 +670,8 @@ class VariantMap extends Variant
 	 */
 	public function toVariantValuesArray() : array<Variant>
 	{
+		// Make sure every value is wrapped
+		$this->materialize();
 		// Return the values array
 		return $this->mData->toValuesArray();
 	}
@@ -403,22 +693,46 @@ class VariantMap extends Variant
 	////////////////////////////////////////////////////////////////////////////
 
 	/**
-	 * This method retuns the data in its original type
+	 * This method retuns the data in its original type, served from the cached view
+	 * The map itself is a copy that can be changed, the containers below it are their own cached immutable views
 	 * @access public
 	 * @name VariantMap::getData()
 	 * @return HH\Map<string, mixed>
 	 */
 	public function getData() : Map<string, mixed>
 	{
+		// Return a copy of the view
+		return $this->getImmutableData()->toMap();
+	}
+
+	/**
+	 * This method returns the data as an immutable view, it is cached until this map or anything below it changes
+	 * Raw values in lazy mode are read as-is, so building the view never wraps them
+	 * @access public
+	 * @name VariantMap::getImmutableData()
+	 * @return HH\ImmMap<string, mixed>
+	 */
+	public function getImmutableData() : ImmMap<string, mixed>
+	{
+		// Check for a cached view nothing has changed under since it was built
+		if (($this->mDataCache !== null) && ($this->revision() <= $this->mDataRevision)) {
+			// We're done
+			return $this->mDataCache;
+		}
 		// Create the response map
 		$mapData = Map {};
-		// Iterate over the data map
-		foreach ($this->mData->getIterator() as $strKey => $varValue) {
-			// Reset the data into the new map
+		// Reserve the keys
+		$mapData->reserve($this->mData->count());
+		// Iterate over the stored entries
+		foreach ($this->entryIterator() as $strKey => $mixValue) {
+			// Reset the view of the value into the new map, raw values are used as-is
 			$mapData
-				->set($strKey, $varValue->getData());
+				->set($strKey, (($mixValue instanceof Variant) ? $mixValue->getImmutableData() : $mixValue));
 		}
-		// Return the data
-		return $mapData;
+		// Cache the view with the change count it is current as of
+		$this->mDataCache    = $mapData->toImmMap();
+		$this->mDataRevision = self::$mRevisionCounter;
+		// Return the view
+		return $this->mDataCache;
 	}
 }
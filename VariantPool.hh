@@ -0,0 +1,245 @@
+<?hh
+
+///////////////////////////////////////////////////////////////////////////////
+/// VariantPool Class Definition /////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////////////////
+
+/**
+ * An opt-in pool of shared Variants for null, booleans, small integers and short strings, which Variant::Factory() hands out while it is enabled
+ * Pooled instances are flagged as interned and copied on write, VariantMap::at() and VariantList::at() swap one for a private copy before handing it out
+ * and Variant::replace() on one changes and returns a private copy, so the pooled instance is never changed
+ */
+class VariantPool
+{
+	//////////////////////////////////////////////////////////////////////////////
+	/// Constants ///////////////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////
+
+	/**
+	 * This constant contains the estimated size of a scalar Variant instance in bytes, used to report the memory saved
+	 * @name VariantPool::InstanceBytes
+	 * @var int
+	 */
+	const int InstanceBytes = 96;
+
+	//////////////////////////////////////////////////////////////////////////////
+	/// Properties //////////////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////
+
+	/**
+	 * This property tells Variant::Factory() whether or not to hand out pooled instances
+	 * @access protected
+	 * @name VariantPool::$mEnabled
+	 * @var bool
+	 */
+	protected static bool $mEnabled             = false;
+
+	/**
+	 * This property counts the requests answered with a pooled instance
+	 * @access protected
+	 * @name VariantPool::$mHits
+	 * @var int
+	 */
+	protected static int $mHits                 = 0;
+
+	/**
+	 * This property contains the largest integer that is pooled
+	 * @access protected
+	 * @name VariantPool::$mMaxInteger
+	 * @var int
+	 */
+	protected static int $mMaxInteger           = 1023;
+
+	/**
+	 * This property contains the most instances the pool holds
+	 * @access protected
+	 * @name VariantPool::$mMaxSize
+	 * @var int
+	 */
+	protected static int $mMaxSize              = 65536;
+
+	/**
+	 * This property contains the longest string, in bytes, that is pooled
+	 * @access protected
+	 * @name VariantPool::$mMaxStringLength
+	 * @var int
+	 */
+	protected static int $mMaxStringLength      = 16;
+
+	/**
+	 * This property contains the smallest integer that is pooled
+	 * @access protected
+	 * @name VariantPool::$mMinInteger
+	 * @var int
+	 */
+	protected static int $mMinInteger           = -128;
+
+	/**
+	 * This property counts the requests for a poolable value that had to create an instance
+	 * @access protected
+	 * @name VariantPool::$mMisses
+	 * @var int
+	 */
+	protected static int $mMisses               = 0;
+
+	/**
+	 * This property contains the pooled instances, keyed by their tagged value
+	 * @access protected
+	 * @name VariantPool::$mPool
+	 * @var HH\Map<string, Variant>
+	 */
+	protected static Map<string, Variant> $mPool = Map {};
+
+	//////////////////////////////////////////////////////////////////////////////
+	/// Public Static Methods ///////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////
+
+	/**
+	 * This method sets which values are pooled, the pool is emptied so every instance in it fits the new limits
+	 * @access public
+	 * @name VariantPool::configure()
+	 * @param int $intMaxStringLength [16]
+	 * @param int $intMinInteger [-128]
+	 * @param int $intMaxInteger [1023]
+	 * @param int $intMaxSize [65536]
+	 * @return void
+	 * @static
+	 */
+	public static function configure(int $intMaxStringLength = 16, int $intMinInteger = -128, int $intMaxInteger = 1023, int $intMaxSize = 65536) : void
+	{
+		// Set the limits
+		self::$mMaxStringLength = $intMaxStringLength;
+		self::$mMinInteger      = $intMinInteger;
+		self::$mMaxInteger      = $intMaxInteger;
+		self::$mMaxSize         = $intMaxSize;
+		// Empty the pool
+		self::$mPool            = Map {};
+	}
+
+	/**
+	 * This method turns interning off, instances already handed out stay shared
+	 * @access public
+	 * @name VariantPool::disable()
+	 * @return void
+	 * @static
+	 */
+	public static function disable() : void
+	{
+		// Turn the pool off
+		self::$mEnabled = false;
+	}
+
+	/**
+	 * This method turns interning on for Variant::Factory()
+	 * @access public
+	 * @name VariantPool::enable()
+	 * @return void
+	 * @static
+	 */
+	public static function enable() : void
+	{
+		// Turn the pool on
+		self::$mEnabled = true;
+	}
+
+	/**
+	 * This method returns whether or not interning is on
+	 * @access public
+	 * @name VariantPool::enabled()
+	 * @return bool
+	 * @static
+	 */
+	public static function enabled() : bool
+	{
+		// Return the status
+		return self::$mEnabled;
+	}
+
+	/**
+	 * This method returns the pooled instance for a scalar, values the pool does not hold get a new private instance
+	 * @access public
+	 * @name VariantPool::intern()
+	 * @param mixed $mixData
+	 * @return Variant
+	 * @static
+	 */
+	public static function intern(mixed $mixData) : Variant
+	{
+		// Build the key for the value
+		if ($mixData === null) {
+			// Tag the null
+			$strKey = 'n';
+		} elseif (is_bool($mixData)) {
+			// Tag the boolean
+			$strKey = ($mixData ? 'b1' : 'b0');
+		} elseif (is_int($mixData) && ($mixData >= self::$mMinInteger) && ($mixData <= self::$mMaxInteger)) {
+			// Tag the integer
+			$strKey = 'i'.$mixData;
+		} elseif (is_string($mixData) && (strlen($mixData) <= self::$mMaxStringLength)) {
+			// Tag the string
+			$strKey = 's'.$mixData;
+		} else {
+			// Return a private instance
+			return new Variant($mixData);
+		}
+		// Grab the pooled instance
+		$varValue = self::$mPool->get($strKey);
+		// Check for a hit
+		if ($varValue !== null) {
+			// Count the hit
+			++self::$mHits;
+			// We're done
+			return $varValue;
+		}
+		// Count the miss
+		++self::$mMisses;
+		// Check for a full pool
+		if (self::$mPool->count() >= self::$mMaxSize) {
+			// Return a private instance
+			return new Variant($mixData);
+		}
+		// Create the shared instance
+		$varValue = new Variant($mixData, true);
+		// Pool the instance
+		self::$mPool->set($strKey, $varValue);
+		// We're done
+		return $varValue;
+	}
+
+	/**
+	 * This method empties the pool and resets the counters
+	 * @access public
+	 * @name VariantPool::reset()
+	 * @return void
+	 * @static
+	 */
+	public static function reset() : void
+	{
+		// Empty the pool
+		self::$mPool   = Map {};
+		// Reset the counters
+		self::$mHits   = 0;
+		self::$mMisses = 0;
+	}
+
+	/**
+	 * This method returns the hits, misses, hit rate in percent, pool size and estimated bytes saved by sharing instances
+	 * @access public
+	 * @name VariantPool::stats()
+	 * @return HH\Map<string, num>
+	 * @static
+	 */
+	public static function stats() : Map<string, num>
+	{
+		// Localize the requests
+		$intRequests = (self::$mHits + self::$mMisses);
+		// Return the stats
+		return Map {
+			'hits'       => self::$mHits,
+			'misses'     => self::$mMisses,
+			'hitRate'    => (($intRequests === 0) ? 0.0 : ((self::$mHits / $intRequests) * 100)),
+			'size'       => self::$mPool->count(),
+			'bytesSaved' => (self::$mHits * self::InstanceBytes)
+		};
+	}
+}
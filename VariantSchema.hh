@@ -0,0 +1,379 @@
+<?hh
+
+///////////////////////////////////////////////////////////////////////////////
+/// VariantSchema Class Definition ///////////////////////////////////////////
+/////////////////////////////////////////////////////////////////////////////
+
+/**
+ * A row layout registered once, each column has a name, a declared Type and whether or not it can be null
+ * The slot of every name, exact and lowercase, is resolved when the column is added, so SchemaVariantMaps never hash or fold a key per row
+ */
+class VariantSchema
+{
+	//////////////////////////////////////////////////////////////////////////////
+	/// Properties //////////////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////
+
+	/**
+	 * This property maps each lowercase column name to the slot of the first column that folds to it
+	 * @access protected
+	 * @name VariantSchema::$mFoldedSlots
+	 * @var HH\Map<string, int>
+	 */
+	protected Map<string, int> $mFoldedSlots                  = Map {};
+
+	/**
+	 * This property contains the name the schema is registered under
+	 * @access protected
+	 * @name VariantSchema::$mName
+	 * @var string
+	 */
+	protected string $mName                                   = '';
+
+	/**
+	 * This property contains the column names, in slot order
+	 * @access protected
+	 * @name VariantSchema::$mNames
+	 * @var HH\Vector<string>
+	 */
+	protected Vector<string> $mNames                          = Vector {};
+
+	/**
+	 * This property contains whether or not each column can be null, in slot order
+	 * @access protected
+	 * @name VariantSchema::$mNullable
+	 * @var HH\Vector<bool>
+	 */
+	protected Vector<bool> $mNullable                         = Vector {};
+
+	/**
+	 * This property contains every registered schema, keyed by name
+	 * @access protected
+	 * @name VariantSchema::$mSchemas
+	 * @var HH\Map<string, VariantSchema>
+	 */
+	protected static Map<string, VariantSchema> $mSchemas     = Map {};
+
+	/**
+	 * This property maps each column name to its slot
+	 * @access protected
+	 * @name VariantSchema::$mSlots
+	 * @var HH\Map<string, int>
+	 */
+	protected Map<string, int> $mSlots                        = Map {};
+
+	/**
+	 * This property contains the declared type of each column, in slot order
+	 * @access protected
+	 * @name VariantSchema::$mTypes
+	 * @var HH\Vector<Type>
+	 */
+	protected Vector<Type> $mTypes                            = Vector {};
+
+	//////////////////////////////////////////////////////////////////////////////
+	/// Constructor /////////////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////
+
+	/**
+	 * This method sets up an empty schema and registers it under $strName
+	 * @access public
+	 * @name VariantSchema::__construct()
+	 * @param string $strName
+	 * @return void
+	 */
+	public function __construct(string $strName) : void
+	{
+		// Set the name into the instance
+		$this->mName        = $strName;
+		// Create the layout
+		$this->mFoldedSlots = Map {};
+		$this->mNames       = Vector {};
+		$this->mNullable    = Vector {};
+		$this->mSlots       = Map {};
+		$this->mTypes       = Vector {};
+		// Register the schema
+		self::$mSchemas->set($strName, $this);
+	}
+
+	//////////////////////////////////////////////////////////////////////////////
+	/// Static Constructor //////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////
+
+	/**
+	 * This method instantiates and registers an empty schema
+	 * @access public
+	 * @name VariantSchema::Factory()
+	 * @param string $strName
+	 * @return VariantSchema
+	 * @static
+	 */
+	public static function Factory(string $strName) : VariantSchema
+	{
+		// Return the new instance
+		return new self($strName);
+	}
+
+	//////////////////////////////////////////////////////////////////////////////
+	/// Public Static Methods ///////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////
+
+	/**
+	 * This method returns a registered schema
+	 * @access public
+	 * @name VariantSchema::named()
+	 * @param string $strName
+	 * @return VariantSchema
+	 * @static
+	 * @throws Exception
+	 */
+	public static function named(string $strName) : VariantSchema
+	{
+		// Grab the schema
+		$vscSchema = self::$mSchemas->get($strName);
+		// Make sure it is registered
+		if ($vscSchema === null) {
+			// Throw an exception
+			throw new Exception('No VariantSchema is registered as '.$strName.'.');
+		}
+		// We're done
+		return $vscSchema;
+	}
+
+	//////////////////////////////////////////////////////////////////////////////
+	/// Protected Methods ///////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////
+
+	/**
+	 * This method checks a string for a JSON column, it must decode to a JSON object the way Variant detects VJson
+	 * @access protected
+	 * @name VariantSchema::coerceJson()
+	 * @param int $intSlot
+	 * @param string $strValue
+	 * @return string
+	 * @throws Exception
+	 */
+	protected function coerceJson(int $intSlot, string $strValue) : string
+	{
+		// Make sure the string is a JSON object
+		if ((new Variant($strValue))->getType() !== Type::VJson) {
+			// Throw an exception
+			throw new Exception('Column '.$this->mNames->at($intSlot).' of VariantSchema '.$this->mName.' cannot hold a string that is not a JSON object.');
+		}
+		// We're done
+		return $strValue;
+	}
+
+	//////////////////////////////////////////////////////////////////////////////
+	/// Public Methods //////////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////
+
+	/**
+	 * This method adds a column to the end of the layout
+	 * @access public
+	 * @name VariantSchema::column()
+	 * @param string $strName
+	 * @param Type $typeColumn
+	 * @param bool $blnNullable [true]
+	 * @return VariantSchema $this
+	 * @throws Exception
+	 */
+	public function column(string $strName, Type $typeColumn, bool $blnNullable = true) : VariantSchema
+	{
+		// Make sure the column is new
+		if ($this->mSlots->containsKey($strName)) {
+			// Throw an exception
+			throw new Exception('VariantSchema '.$this->mName.' already has a column named '.$strName.'.');
+		}
+		// Localize the slot
+		$intSlot = $this->mNames->count();
+		// Add the column
+		$this->mNames->add($strName);
+		$this->mTypes->add($typeColumn);
+		$this->mNullable->add($blnNullable);
+		// Resolve the name
+		$this->mSlots->set($strName, $intSlot);
+		// Check the folded name, the first column to fold to it wins
+		if ($this->mFoldedSlots->containsKey(strtolower($strName)) === false) {
+			// Resolve the folded name
+			$this->mFoldedSlots->set(strtolower($strName), $intSlot);
+		}
+		// We're done
+		return $this;
+	}
+
+	/**
+	 * This method coerces a value to the declared type of a slot
+	 * @access public
+	 * @name VariantSchema::coerce()
+	 * @param int $intSlot
+	 * @param mixed $mixValue
+	 * @return mixed
+	 * @throws Exception
+	 */
+	public function coerce(int $intSlot, mixed $mixValue) : mixed
+	{
+		// Unwrap a Variant
+		if ($mixValue instanceof Variant) {
+			// Use the raw value
+			$mixValue = $mixValue->getData();
+		}
+		// Check for a null
+		if ($mixValue === null) {
+			// Make sure the column can be null
+			if ($this->mNullable->at($intSlot) === false) {
+				// Throw an exception
+				throw new Exception('Column '.$this->mNames->at($intSlot).' of VariantSchema '.$this->mName.' cannot be null.');
+			}
+			// We're done
+			return null;
+		}
+		// Localize the declared type
+		$typeDeclared = $this->mTypes->at($intSlot);
+		// Check for a value that already has the declared type, which is the common case for database rows
+		switch ($typeDeclared) {
+			case Type::VInteger : if (is_int($mixValue))           { return $mixValue; } break; // integer
+			case Type::VString  : if (is_string($mixValue))        { return $mixValue; } break; // string
+			case Type::VDouble  :
+			case Type::VFloat   : if (is_float($mixValue))         { return $mixValue; } break; // double and float
+			case Type::VBoolean : if (is_bool($mixValue))          { return $mixValue; } break; // boolean
+			case Type::VJson    : if (is_string($mixValue))        { return $this->coerceJson($intSlot, $mixValue); } break; // json
+			case Type::VArray   : if (is_array($mixValue))         { return $mixValue; } break; // array
+			case Type::VMap     : if ($mixValue instanceof Map)    { return $mixValue; } break; // HH\Map
+			case Type::VVector  : if ($mixValue instanceof Vector) { return $mixValue; } break; // HH\Vector
+		}
+		// Wrap the value
+		$varValue = new Variant($mixValue);
+		// Make sure it converts
+		if ($varValue->can($typeDeclared) === false) {
+			// Throw an exception
+			throw new Exception('Column '.$this->mNames->at($intSlot).' of VariantSchema '.$this->mName.' cannot hold a '.$varValue->getType().'.');
+		}
+		// Return the converted value
+		return $varValue->convert($typeDeclared);
+	}
+
+	/**
+	 * This method returns the number of columns
+	 * @access public
+	 * @name VariantSchema::count()
+	 * @return int
+	 */
+	public function count() : int
+	{
+		// Return the column count
+		return $this->mNames->count();
+	}
+
+	/**
+	 * This method creates a row with this layout
+	 * @access public
+	 * @name VariantSchema::map()
+	 * @param KeyedTraversable<string, mixed> $ktsSource [null]
+	 * @return SchemaVariantMap
+	 */
+	public function map(?KeyedTraversable<string, mixed> $ktsSource = null) : SchemaVariantMap
+	{
+		// Return the new row
+		return new SchemaVariantMap($this, $ktsSource);
+	}
+
+	/**
+	 * This method creates a VariantList of rows with this layout
+	 * @access public
+	 * @name VariantSchema::rows()
+	 * @param Traversable<KeyedTraversable<string, mixed>> $trvRows
+	 * @return VariantList
+	 */
+	public function rows(Traversable<KeyedTraversable<string, mixed>> $trvRows) : VariantList
+	{
+		// Create the response list
+		$vltReturn = new VariantList();
+		// Iterate over the rows
+		foreach ($trvRows as $ktsRow) {
+			// Add the row
+			$vltReturn->addVariant(new SchemaVariantMap($this, $ktsRow));
+		}
+		// We're done
+		return $vltReturn;
+	}
+
+	/**
+	 * This method returns the slot of a column, an exact name is tried before a case-insensitive one, null if there is no such column
+	 * @access public
+	 * @name VariantSchema::slotOf()
+	 * @param string $strKey
+	 * @return int
+	 */
+	public function slotOf(string $strKey) : ?int
+	{
+		// Return the exact slot, or the folded one
+		return ($this->mSlots->get($strKey) ?? $this->mFoldedSlots->get(strtolower($strKey)));
+	}
+
+	//////////////////////////////////////////////////////////////////////////////
+	/// Getters /////////////////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////
+
+	/**
+	 * This method returns the name the schema is registered under
+	 * @access public
+	 * @name VariantSchema::getName()
+	 * @return string
+	 */
+	public function getName() : string
+	{
+		// Return the name
+		return $this->mName;
+	}
+
+	/**
+	 * This method returns the name of the column in a slot
+	 * @access public
+	 * @name VariantSchema::getNameAt()
+	 * @param int $intSlot
+	 * @return string
+	 */
+	public function getNameAt(int $intSlot) : string
+	{
+		// Return the name
+		return $this->mNames->at($intSlot);
+	}
+
+	/**
+	 * This method returns the column names in slot order
+	 * @access public
+	 * @name VariantSchema::getNames()
+	 * @return HH\ImmVector<string>
+	 */
+	public function getNames() : ImmVector<string>
+	{
+		// Return the names
+		return $this->mNames->toImmVector();
+	}
+
+	/**
+	 * This method returns the declared type of the column in a slot
+	 * @access public
+	 * @name VariantSchema::getTypeAt()
+	 * @param int $intSlot
+	 * @return Type
+	 */
+	public function getTypeAt(int $intSlot) : Type
+	{
+		// Return the type
+		return $this->mTypes->at($intSlot);
+	}
+
+	/**
+	 * This method returns whether or not the column in a slot can be null
+	 * @access public
+	 * @name VariantSchema::isNullableAt()
+	 * @param int $intSlot
+	 * @return bool
+	 */
+	public function isNullableAt(int $intSlot) : bool
+	{
+		// Return the nullability
+		return $this->mNullable->at($intSlot);
+	}
+}
@@ -0,0 +1,392 @@
+<?hh
+
+///////////////////////////////////////////////////////////////////////////////
+/// VariantSqlBuilder Class Definition ///////////////////////////////////////
+/////////////////////////////////////////////////////////////////////////////
+
+class VariantSqlBuilder
+{
+	//////////////////////////////////////////////////////////////////////////////
+	/// Constants ///////////////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////
+
+	/**
+	 * This constant contains the number of IN-list values that are escaped together in one batch
+	 * @name VariantSqlBuilder::BatchSize
+	 * @var int
+	 */
+	const int BatchSize = 1024;
+
+	/**
+	 * This constant contains the byte used to join strings for batch escaping, addslashes() leaves it untouched
+	 * @name VariantSqlBuilder::Separator
+	 * @var string
+	 */
+	const string Separator = "\x1F";
+
+	//////////////////////////////////////////////////////////////////////////////
+	/// Properties //////////////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////
+
+	/**
+	 * This property contains the maximum size of a statement in bytes, usually the server's max_allowed_packet
+	 * @access protected
+	 * @name VariantSqlBuilder::$mMaxBytes
+	 * @var int
+	 */
+	protected int $mMaxBytes = 1048576;
+
+	//////////////////////////////////////////////////////////////////////////////
+	/// Constructor /////////////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////
+
+	/**
+	 * This method sets up the builder with a statement size cap
+	 * @access public
+	 * @name VariantSqlBuilder::__construct()
+	 * @param int $intMaxBytes [1048576]
+	 * @return void
+	 */
+	public function __construct(int $intMaxBytes = 1048576) : void
+	{
+		// Set the cap into the instance
+		$this->mMaxBytes = $intMaxBytes;
+	}
+
+	//////////////////////////////////////////////////////////////////////////////
+	/// Static Constructor //////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////
+
+	/**
+	 * This method instantiates and sets up the builder with a statement size cap
+	 * @access public
+	 * @name VariantSqlBuilder::Factory()
+	 * @param int $intMaxBytes [1048576]
+	 * @return VariantSqlBuilder
+	 * @static
+	 */
+	public static function Factory(int $intMaxBytes = 1048576) : VariantSqlBuilder
+	{
+		// Return the new instance
+		return new self($intMaxBytes);
+	}
+
+	//////////////////////////////////////////////////////////////////////////////
+	/// Protected Static Methods ////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////
+
+	/**
+	 * This method escapes a batch of strings with a single addslashes() call
+	 * @access protected
+	 * @name VariantSqlBuilder::escapeBatch()
+	 * @param array<string> $arrStrings
+	 * @return array<string>
+	 * @static
+	 */
+	protected static function escapeBatch(array<string> $arrStrings) : array<string>
+	{
+		// Check for data
+		if (count($arrStrings) === 0) {
+			// We're done
+			return $arrStrings;
+		}
+		// Escape the joined buffer and split it again
+		$arrEscaped = explode(self::Separator, addslashes(implode(self::Separator, $arrStrings)));
+		// Check for a string that contained the separator itself
+		if (count($arrEscaped) !== count($arrStrings)) {
+			// Escape the strings one at a time
+			return array_map('addslashes', $arrStrings);
+		}
+		// We're done
+		return $arrEscaped;
+	}
+
+	/**
+	 * This method determines the literal kind for a column from its first non-null value
+	 * @access protected
+	 * @name VariantSqlBuilder::kindOf()
+	 * @param mixed $mixValue
+	 * @return Type
+	 * @static
+	 */
+	protected static function kindOf(mixed $mixValue) : Type
+	{
+		// Determine the type
+		switch (Variant::Factory($mixValue)->getType()) {
+			case Type::VBoolean : return Type::VBoolean; break; // boolean
+			case Type::VDouble  : return Type::VDouble;  break; // double
+			case Type::VInteger : return Type::VInteger; break; // integer
+			case Type::VBinary  :                               // binary
+			case Type::VJson    :                               // json
+			case Type::VString  : return Type::VString;  break; // string
+		}
+		// Everything else goes through Variant::toMySqlString()
+		return Type::VUnknown;
+	}
+
+	/**
+	 * This method converts a value that is not a string to a MySQL literal, strings are escaped in batches by the caller
+	 * @access protected
+	 * @name VariantSqlBuilder::literal()
+	 * @param mixed $mixValue
+	 * @param Type $typeKind
+	 * @return string
+	 * @static
+	 */
+	protected static function literal(mixed $mixValue, Type $typeKind) : string
+	{
+		// Check for null
+		if ($mixValue === null) {
+			// Return the null literal
+			return 'NULL';
+		}
+		// Use the kernel for the column when the value matches it
+		if (($typeKind === Type::VInteger) && is_int($mixValue)) {
+			// Return the integer
+			return (string) $mixValue;
+		} elseif (($typeKind === Type::VDouble) && is_float($mixValue) && is_finite($mixValue)) {
+			// Return the double
+			return (string) $mixValue;
+		} elseif (($typeKind === Type::VBoolean) && is_bool($mixValue)) {
+			// Return the boolean
+			return ($mixValue ? '1' : '0');
+		}
+		// Return the generic conversion
+		return Variant::Factory($mixValue)->toMySqlString();
+	}
+
+	/**
+	 * This method quotes a table or column name
+	 * @access protected
+	 * @name VariantSqlBuilder::quoteName()
+	 * @param string $strName
+	 * @return string
+	 * @static
+	 */
+	protected static function quoteName(string $strName) : string
+	{
+		// Return the quoted name
+		return '`'.str_replace('`', '``', $strName).'`';
+	}
+
+	//////////////////////////////////////////////////////////////////////////////
+	/// Public Methods //////////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////
+
+	/**
+	 * This method builds parenthesized IN-lists from a VariantList, each one capped at the statement size
+	 * @access public
+	 * @name VariantSqlBuilder::inLists()
+	 * @param VariantList $vltValues
+	 * @param int $intReserved [0] The bytes the rest of the statement needs
+	 * @return HH\Vector<string>
+	 */
+	public function inLists(VariantList $vltValues, int $intReserved = 0) : Vector<string>
+	{
+		// Create the response vector
+		$vecReturn = Vector {};
+		// Localize the budget for the list
+		$intBudget = ($this->mMaxBytes - $intReserved);
+		// Create the list buffer
+		$strList   = '';
+		// Localize the column kind
+		$typeKind  = null;
+		// Create the pending batch
+		$vecBatch  = Vector {};
+		// Localize the number of values
+		$intCount  = $vltValues->count();
+		// Iterate over the values
+		foreach ($vltValues->getIterator() as $intIndex => $varValue) {
+			// Add the raw value to the batch
+			$vecBatch->add($varValue->getData());
+			// Check for a full batch or the last value
+			if (($vecBatch->count() < self::BatchSize) && ($intIndex < ($intCount - 1))) {
+				// Keep collecting
+				continue;
+			}
+			// Collect the strings in the batch
+			$arrStrings = [];
+			// Iterate over the batch
+			foreach ($vecBatch->getIterator() as $mixValue) {
+				// Check for the first non-null value
+				if (($typeKind === null) && ($mixValue !== null)) {
+					// Determine the kind once
+					$typeKind = self::kindOf($mixValue);
+				}
+				// Check for a string
+				if (($typeKind === Type::VString) && is_string($mixValue)) {
+					// Add the string
+					$arrStrings[] = $mixValue;
+				}
+			}
+			// Escape the strings together
+			$arrEscaped = self::escapeBatch($arrStrings);
+			// Localize the position in the escaped strings
+			$intString  = 0;
+			// Iterate over the batch
+			foreach ($vecBatch->getIterator() as $mixValue) {
+				// Convert the value
+				if (($typeKind === Type::VString) && is_string($mixValue)) {
+					// Quote the escaped string
+					$strValue = "'".$arrEscaped[$intString++]."'";
+				} else {
+					// Convert the literal
+					$strValue = self::literal($mixValue, $typeKind ?? Type::VUnknown);
+				}
+				// Check the budget, the parentheses and the comma take three bytes
+				if (($strList !== '') && ((strlen($strList) + strlen($strValue) + 3) > $intBudget)) {
+					// Close the list
+					$vecReturn->add('('.$strList.')');
+					// Reset the list
+					$strList = '';
+				}
+				// Append the value
+				$strList .= (($strList === '') ? $strValue : (','.$strValue));
+			}
+			// Reset the batch
+			$vecBatch = Vector {};
+		}
+		// Check for a remainder
+		if ($strList !== '') {
+			// Close the list
+			$vecReturn->add('('.$strList.')');
+		}
+		// We're done
+		return $vecReturn;
+	}
+
+	/**
+	 * This method builds multi-row INSERT statements from a VariantList of VariantMap rows, each one capped at the statement size
+	 * @access public
+	 * @name VariantSqlBuilder::insertStatements()
+	 * @param string $strTable
+	 * @param HH\Vector<string> $vecColumns
+	 * @param VariantList $vltRows
+	 * @param string $strVerb [INSERT]
+	 * @return HH\Vector<string>
+	 */
+	public function insertStatements(string $strTable, Vector<string> $vecColumns, VariantList $vltRows, string $strVerb = 'INSERT') : Vector<string>
+	{
+		// Create the response vector
+		$vecReturn = Vector {};
+		// Send the statements to the response vector
+		$this->insertTo(function(string $strStatement) use ($vecReturn) {
+			// Add the statement
+			$vecReturn->add($strStatement);
+		}, $strTable, $vecColumns, $vltRows, $strVerb);
+		// We're done
+		return $vecReturn;
+	}
+
+	/**
+	 * This method builds multi-row INSERT statements from a VariantList of VariantMap rows and sends each one to a sink
+	 * @access public
+	 * @name VariantSqlBuilder::insertTo()
+	 * @param callable $fnSink
+	 * @param string $strTable
+	 * @param HH\Vector<string> $vecColumns
+	 * @param VariantList $vltRows
+	 * @param string $strVerb [INSERT]
+	 * @return int The number of statements sent to the sink
+	 * @throws Exception
+	 */
+	public function insertTo(callable $fnSink, string $strTable, Vector<string> $vecColumns, VariantList $vltRows, string $strVerb = 'INSERT') : int
+	{
+		// Quote the column names
+		$arrNames = [];
+		// Iterate over the columns
+		foreach ($vecColumns->getIterator() as $strColumn) {
+			// Add the quoted name
+			$arrNames[] = self::quoteName($strColumn);
+		}
+		// Create the statement prefix
+		$strPrefix     = $strVerb.' INTO '.self::quoteName($strTable).' ('.implode(',', $arrNames).') VALUES ';
+		// Localize the real key and the kind of each column, both are resolved once
+		$vecKeys       = new Vector($vecColumns);
+		$vecKinds      = Vector {};
+		// Reserve the kinds
+		$vecKinds->resize($vecColumns->count(), null);
+		// Create the statement buffer
+		$strStatement  = '';
+		// Create the statement counter
+		$intStatements = 0;
+		// Iterate over the rows
+		foreach ($vltRows->getIterator() as $varRow) {
+			// Make sure we have a map
+			if (($varRow instanceof VariantMap) === false) {
+				// Throw an exception
+				throw new Exception('VariantSqlBuilder::insertTo() expects a VariantList of VariantMap rows.');
+			}
+			// Collect the raw values and the strings of the row
+			$arrValues  = [];
+			$arrStrings = [];
+			// Iterate over the columns
+			foreach ($vecKeys->getIterator() as $intColumn => $strKey) {
+				// Check for an unresolved key
+				if (($vecKinds->at($intColumn) === null) && (($strRealKey = $varRow->search($strKey)) !== null)) {
+					// Keep the real key for the next rows
+					$vecKeys->set($intColumn, $strRealKey);
+					$strKey = $strRealKey;
+				}
+				// Grab the raw value
+				$mixValue = $varRow->at($strKey)->getData();
+				// Check for the first non-null value
+				if (($vecKinds->at($intColumn) === null) && ($mixValue !== null)) {
+					// Determine the kind once
+					$vecKinds->set($intColumn, self::kindOf($mixValue));
+				}
+				// Check for a string
+				if (($vecKinds->at($intColumn) === Type::VString) && is_string($mixValue)) {
+					// Add the string
+					$arrStrings[] = $mixValue;
+				}
+				// Add the value
+				$arrValues[] = $mixValue;
+			}
+			// Escape the strings of the row together
+			$arrEscaped = self::escapeBatch($arrStrings);
+			// Localize the position in the escaped strings
+			$intString  = 0;
+			// Create the tuple
+			$strTuple   = '(';
+			// Iterate over the values
+			foreach ($arrValues as $intColumn => $mixValue) {
+				// Check for a preceding value
+				if ($intColumn > 0) {
+					// Append the comma
+					$strTuple .= ',';
+				}
+				// Convert the value
+				if (($vecKinds->at($intColumn) === Type::VString) && is_string($mixValue)) {
+					// Append the escaped string
+					$strTuple .= "'".$arrEscaped[$intString++]."'";
+				} else {
+					// Append the literal
+					$strTuple .= self::literal($mixValue, $vecKinds->at($intColumn) ?? Type::VUnknown);
+				}
+			}
+			// Close the tuple
+			$strTuple .= ')';
+			// Check the budget
+			if (($strStatement !== '') && ((strlen($strStatement) + strlen($strTuple) + 1) > $this->mMaxBytes)) {
+				// Send the statement to the sink
+				$fnSink($strStatement);
+				// Count the statement
+				++$intStatements;
+				// Reset the statement
+				$strStatement = '';
+			}
+			// Append the tuple
+			$strStatement .= (($strStatement === '') ? ($strPrefix.$strTuple) : (','.$strTuple));
+		}
+		// Check for a remainder
+		if ($strStatement !== '') {
+			// Send the statement to the sink
+			$fnSink($strStatement);
+			// Count the statement
+			++$intStatements;
+		}
+		// We're done
+		return $intStatements;
+	}
+}
@@ -0,0 +1,120 @@
+<?hh
+
+///////////////////////////////////////////////////////////////////////////////
+/// VariantStats Class Definition ////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////////////////
+
+/**
+ * An opt-in collector of counters for Variant operations, every call site checks VariantStats::enabled() first so it costs one static read while it is off
+ * Counters are flat names such as "factory.VariantMap", "convert.string>integer", "getType", "json_decode", "json_decode.avoided", "search.fallback", "bytes.implode" and "bytes.json"
+ */
+class VariantStats
+{
+	//////////////////////////////////////////////////////////////////////////////
+	/// Properties //////////////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////
+
+	/**
+	 * This property contains the counters, keyed by name
+	 * @access protected
+	 * @name VariantStats::$mCounters
+	 * @var HH\Map<string, int>
+	 */
+	protected static Map<string, int> $mCounters = Map {};
+
+	/**
+	 * This property tells the call sites whether or not to count
+	 * @access protected
+	 * @name VariantStats::$mEnabled
+	 * @var bool
+	 */
+	protected static bool $mEnabled              = false;
+
+	//////////////////////////////////////////////////////////////////////////////
+	/// Public Static Methods ///////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////
+
+	/**
+	 * This method turns counting off, the counters are kept
+	 * @access public
+	 * @name VariantStats::disable()
+	 * @return void
+	 * @static
+	 */
+	public static function disable() : void
+	{
+		// Turn counting off
+		self::$mEnabled = false;
+	}
+
+	/**
+	 * This method turns counting on
+	 * @access public
+	 * @name VariantStats::enable()
+	 * @return void
+	 * @static
+	 */
+	public static function enable() : void
+	{
+		// Turn counting on
+		self::$mEnabled = true;
+	}
+
+	/**
+	 * This method returns whether or not counting is on
+	 * @access public
+	 * @name VariantStats::enabled()
+	 * @return bool
+	 * @static
+	 */
+	public static function enabled() : bool
+	{
+		// Return the status
+		return self::$mEnabled;
+	}
+
+	/**
+	 * This method adds to a counter, callers check VariantStats::enabled() first
+	 * @access public
+	 * @name VariantStats::increment()
+	 * @param string $strName
+	 * @param int $intBy [1]
+	 * @return void
+	 * @static
+	 */
+	public static function increment(string $strName, int $intBy = 1) : void
+	{
+		// Add to the counter
+		self::$mCounters->set($strName, ((self::$mCounters->get($strName) ?? 0) + $intBy));
+	}
+
+	/**
+	 * This method zeroes every counter, call it at the start of a request to export per-request numbers
+	 * @access public
+	 * @name VariantStats::reset()
+	 * @return void
+	 * @static
+	 */
+	public static function reset() : void
+	{
+		// Drop the counters
+		self::$mCounters = Map {};
+	}
+
+	/**
+	 * This method returns a copy of the counters, sorted by name
+	 * @access public
+	 * @name VariantStats::snapshot()
+	 * @return HH\ImmMap<string, int>
+	 * @static
+	 */
+	public static function snapshot() : ImmMap<string, int>
+	{
+		// Copy the counters
+		$arrCounters = self::$mCounters->toArray();
+		// Sort them by name
+		ksort($arrCounters);
+		// We're done
+		return new ImmMap($arrCounters);
+	}
+}
@@ -0,0 +1,636 @@
+<?hh
+
+///////////////////////////////////////////////////////////////////////////////
+/// VariantTable Class Definition ////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////////////////
+
+/**
+ * A result set stored by column, each key is kept once and each column is a Vector of raw values with null for rows that lacked the key
+ * Rows are only turned into VariantTableRows when they are reached, pluck, filter, group and implode scan the raw columns instead
+ * Each access makes a new row, set(), setVariant(), remove() and clear() on it are written back into the columns, see VariantTableRow
+ */
+class VariantTable extends Variant
+{
+	//////////////////////////////////////////////////////////////////////////////
+	/// Properties //////////////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////
+
+	/**
+	 * This property contains the number of rows in the table
+	 * @access protected
+	 * @name VariantTable::$mCount
+	 * @var int
+	 */
+	protected int $mCount                       = 0;
+
+	/**
+	 * This property contains the columns, keyed by their real name
+	 * @access protected
+	 * @name VariantTable::$mData
+	 * @var HH\Map<string, HH\Vector<mixed>>
+	 */
+	protected Map<string, Vector<mixed>> $mData = Map {};
+
+	/**
+	 * This property maps each lowercase column name to the real name of the first column that folds to it
+	 * @access protected
+	 * @name VariantTable::$mKeyIndex
+	 * @var HH\Map<string, string>
+	 */
+	protected Map<string, string> $mKeyIndex   = Map {};
+
+	//////////////////////////////////////////////////////////////////////////////
+	/// Constructor /////////////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////
+
+	/**
+	 * This method sets up the instance with existing rows
+	 * @access public
+	 * @name VariantTable::__construct()
+	 * @param Traversable<mixed> $trvRows [null]
+	 * @return void
+	 */
+	public function __construct(?Traversable<mixed> $trvRows = null) : void
+	{
+		// Create the columns
+		$this->mData     = Map {};
+		$this->mKeyIndex = Map {};
+		// Check for rows
+		if ($trvRows === null) {
+			// We're done
+			return;
+		}
+		// Iterate over the rows
+		foreach ($trvRows as $mixRow) {
+			// Add the row
+			$this->add($mixRow);
+		}
+	}
+
+	//////////////////////////////////////////////////////////////////////////////
+	/// Static Constructor //////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////
+
+	/**
+	 * This method constructs a new instance from any traversable rows
+	 * @access public
+	 * @name VariantTable::Factory()
+	 * @param Traversable<mixed> $trvRows [null]
+	 * @return VariantTable
+	 * @static
+	 */
+	public static function Factory(?Traversable<mixed> $trvRows = null) : VariantTable
+	{
+		// Return the new instance
+		return new self($trvRows);
+	}
+
+	//////////////////////////////////////////////////////////////////////////////
+	/// Public Static Methods ///////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////
+
+	/**
+	 * This method constructs a new instance from a VariantList<VariantMap>
+	 * @access public
+	 * @name VariantTable::fromVariantList()
+	 * @param VariantList $vltRows
+	 * @return VariantTable
+	 * @static
+	 */
+	public static function fromVariantList(VariantList $vltRows) : VariantTable
+	{
+		// Return the new instance
+		return new self($vltRows->getIterator());
+	}
+
+	//////////////////////////////////////////////////////////////////////////////
+	/// Protected Methods ///////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////
+
+	/**
+	 * This method returns the column for a key with case-insensitivity, null if there is none
+	 * @access protected
+	 * @name VariantTable::columnOf()
+	 * @param string $strKey
+	 * @return HH\Vector<mixed>
+	 */
+	protected function columnOf(string $strKey) : ?Vector<mixed>
+	{
+		// Find the real key
+		$strRealKey = $this->search($strKey);
+		// Return the column
+		return (($strRealKey === null) ? null : $this->mData->at($strRealKey));
+	}
+
+	/**
+	 * This method gathers the raw values of a row from the columns
+	 * @access protected
+	 * @name VariantTable::rowOf()
+	 * @param int $intRow
+	 * @return HH\Map<string, mixed>
+	 */
+	protected function rowOf(int $intRow) : Map<string, mixed>
+	{
+		// Create the row
+		$mapRow = Map {};
+		// Reserve the keys
+		$mapRow->reserve($this->mData->count());
+		// Iterate over the columns
+		foreach ($this->mData->getIterator() as $strKey => $vecColumn) {
+			// Set the value
+			$mapRow->set($strKey, $vecColumn->at($intRow));
+		}
+		// We're done
+		return $mapRow;
+	}
+
+	/**
+	 * This method reports the table as a vector of rows
+	 * @access protected
+	 * @name VariantTable::detectType()
+	 * @return Type
+	 */
+	protected function detectType() : Type
+	{
+		// Return the vector type
+		return Type::VVector;
+	}
+
+	//////////////////////////////////////////////////////////////////////////////
+	/// Public Methods //////////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////
+
+	/**
+	 * This method appends a row, new keys get a column that is null for every earlier row
+	 * @access public
+	 * @name VariantTable::add()
+	 * @param mixed $mixRow
+	 * @return VariantTable $this
+	 * @throws Exception
+	 */
+	public function add(mixed $mixRow) : VariantTable
+	{
+		// Check for a VariantMap
+		if ($mixRow instanceof VariantMap) {
+			// Iterate over its Variants
+			$mixRow = $mixRow->getIterator();
+		} elseif ((is_array($mixRow) || ($mixRow instanceof KeyedTraversable)) === false) {
+			// Throw an exception
+			throw new Exception('VariantTable rows must be maps.');
+		}
+		// Iterate over the row
+		foreach ($mixRow as $mixKey => $mixValue) {
+			// Localize the key
+			$strKey    = (string) $mixKey;
+			// Grab the column
+			$vecColumn = $this->mData->get($strKey);
+			// Check for a new column
+			if ($vecColumn === null) {
+				// Create the column with a null for each earlier row
+				$vecColumn = Vector {};
+				$vecColumn->resize($this->mCount, null);
+				// Set the column into the instance
+				$this->mData->set($strKey, $vecColumn);
+				// Check the key index, the first column to fold to a name wins
+				if ($this->mKeyIndex->containsKey(strtolower($strKey)) === false) {
+					// Index the key
+					$this->mKeyIndex->set(strtolower($strKey), $strKey);
+				}
+			}
+			// Add the raw value
+			$vecColumn->add(($mixValue instanceof Variant) ? $mixValue->getData() : $mixValue);
+		}
+		// Count the row
+		++$this->mCount;
+		// Iterate over the columns
+		foreach ($this->mData->getIterator() as $vecColumn) {
+			// Check for a column the row did not have
+			if ($vecColumn->count() < $this->mCount) {
+				// Fill the gap
+				$vecColumn->add(null);
+			}
+		}
+		// The data has changed
+		$this->invalidate();
+		// We're done
+		return $this;
+	}
+
+	/**
+	 * This method returns a row as a VariantTableRow that writes changes back into the columns, Variant::Factory(null) if there is none
+	 * @access public
+	 * @name VariantTable::at()
+	 * @param int $intRow
+	 * @return Variant
+	 */
+	public function at(int $intRow) : Variant
+	{
+		// Check for the row
+		if (($intRow < 0) || ($intRow >= $this->mCount)) {
+			// Return an empty variant
+			return Variant::Factory(null);
+		}
+		// Return the row, its values are wrapped as they are reached
+		return new VariantTableRow($this, $intRow, $this->rowOf($intRow));
+	}
+
+	/**
+	 * This method extracts the values in a column in their original type, null for every row if there is no such column
+	 * @access public
+	 * @name VariantTable::column()
+	 * @param string $strKey
+	 * @return HH\Vector<mixed>
+	 */
+	public function column(string $strKey) : Vector<mixed>
+	{
+		// Grab the column
+		$vecColumn = $this->columnOf($strKey);
+		// Check for the column
+		if ($vecColumn === null) {
+			// Create a column of nulls
+			$vecColumn = Vector {};
+			$vecColumn->resize($this->mCount, null);
+			// We're done
+			return $vecColumn;
+		}
+		// Return a copy of the column
+		return $vecColumn->toVector();
+	}
+
+	/**
+	 * This method determines whether or not the table has a column using case-insensitivity
+	 * @access public
+	 * @name VariantTable::contains()
+	 * @param string $strKey
+	 * @return bool
+	 */
+	public function contains(string $strKey) : bool
+	{
+		// Return the search status
+		return ($this->search($strKey) !== null);
+	}
+
+	/**
+	 * This method converts the rows to a specified target type, the table converts like a vector of row maps
+	 * Variant::convert() would work on the columns, so toJson() and the other converters are routed through the rows in getData() here
+	 * @access public
+	 * @name VariantTable::convert()
+	 * @param Type $typeTarget
+	 * @return mixed
+	 */
+	public function convert(Type $typeTarget) : mixed
+	{
+		// Return the conversion of the rows
+		return Variant::withType($this->getData(), Type::VVector)->convert($typeTarget);
+	}
+
+	/**
+	 * This method returns the number of rows in the table
+	 * @access public
+	 * @name VariantTable::count()
+	 * @return int
+	 */
+	public function count() : int
+	{
+		// Return the row count
+		return $this->mCount;
+	}
+
+	/**
+	 * This method returns a new table with the rows whose raw value at $strKey passes $fnPredicate, only that column is scanned
+	 * @access public
+	 * @name VariantTable::filter()
+	 * @param string $strKey
+	 * @param callable $fnPredicate
+	 * @return VariantTable
+	 */
+	public function filter(string $strKey, callable $fnPredicate) : VariantTable
+	{
+		// Grab the column
+		$vecColumn = $this->column($strKey);
+		// Create the matching rows
+		$vecRows   = Vector {};
+		// Iterate over the column
+		foreach ($vecColumn->getIterator() as $intRow => $mixValue) {
+			// Check the value
+			if ($fnPredicate($mixValue)) {
+				// Keep the row
+				$vecRows->add($intRow);
+			}
+		}
+		// Return the matching rows
+		return $this->select($vecRows);
+	}
+
+	/**
+	 * This method is an alias of VariantTable::at()
+	 * @access public
+	 * @name VariantTable::get()
+	 * @param int $intRow
+	 * @return Variant
+	 * @see VariantTable::at()
+	 */
+	public function get(int $intRow) : Variant
+	{
+		// Return the row
+		return $this->at($intRow);
+	}
+
+	/**
+	 * This method walks the rows, each one is created as the iteration reaches it
+	 * @access public
+	 * @name VariantTable::getIterator()
+	 * @return KeyedIterator<int, Variant>
+	 */
+	public function getIterator() : KeyedIterator<int, Variant>
+	{
+		// Iterate over the rows
+		for ($intRow = 0; $intRow < $this->mCount; ++$intRow) {
+			// Yield the row
+			yield $intRow => $this->at($intRow);
+		}
+	}
+
+	/**
+	 * This method groups the table into a VariantMap<string, VariantTable> by the value at $strKey, rows with an empty key are skipped
+	 * @access public
+	 * @name VariantTable::group()
+	 * @param string $strKey
+	 * @return VariantMap
+	 */
+	public function group(string $strKey) : VariantMap
+	{
+		// Create the rows of each group
+		$mapGroups = Map {};
+		// Iterate over the key column
+		foreach ($this->column($strKey)->getIterator() as $intRow => $mixValue) {
+			// Check for an empty key
+			if (empty($mixValue)) {
+				// Next row
+				continue;
+			}
+			// Convert the key once
+			$strGroup = ((is_string($mixValue) || is_int($mixValue)) ? (string) $mixValue : Variant::Factory($mixValue)->toString());
+			// Grab the group
+			$vecGroup = $mapGroups->get($strGroup);
+			// Check for a new group
+			if ($vecGroup === null) {
+				// Create the group
+				$vecGroup = Vector {};
+				// Set the group into the map
+				$mapGroups->set($strGroup, $vecGroup);
+			}
+			// Add the row
+			$vecGroup->add($intRow);
+		}
+		// Create a response map
+		$mapReturn = new VariantMap();
+		// Iterate over the groups
+		foreach ($mapGroups->getIterator() as $strGroup => $vecGroup) {
+			// Set the group into the response map
+			$mapReturn->setVariant($strGroup, $this->select($vecGroup));
+		}
+		// Return the response map
+		return $mapReturn;
+	}
+
+	/**
+	 * This method implodes a column into a string list
+	 * @access public
+	 * @name VariantTable::implode()
+	 * @param string $strKey
+	 * @param string $strDelimiter [,]
+	 * @param bool $blnForMySQL [false]
+	 * @return string
+	 */
+	public function implode(string $strKey, string $strDelimiter = ',', bool $blnForMySQL = false) : string
+	{
+		// Wrap the column once, the list converters scan it raw
+		$varColumn = new Variant($this->column($strKey));
+		// Return the imploded string
+		return ($blnForMySQL ? $varColumn->toMySqlStringList($strDelimiter) : $varColumn->toStringList($strDelimiter));
+	}
+
+	/**
+	 * This method returns whether or not the table has no rows
+	 * @access public
+	 * @name VariantTable::isEmpty()
+	 * @return bool
+	 */
+	public function isEmpty() : bool
+	{
+		// Return the empty status
+		return ($this->mCount === 0);
+	}
+
+	/**
+	 * This method extracts the values in a column into a new VariantList, which stays a packed column when the values share a type
+	 * @access public
+	 * @name VariantTable::pluck()
+	 * @param string $strKey
+	 * @return VariantList
+	 */
+	public function pluck(string $strKey) : VariantList
+	{
+		// Return the column, the values are only wrapped when they are reached
+		return VariantList::Factory($this->column($strKey), true);
+	}
+
+	/**
+	 * This method searches the columns for a key with case-insensitivity, if one is found the actual key name is returned, null elsewise
+	 * @access public
+	 * @name VariantTable::search()
+	 * @param string $strKey
+	 * @return string
+	 */
+	public function search(string $strKey) : ?string
+	{
+		// Check for an exact match
+		if ($this->mData->containsKey($strKey)) {
+			// We're done
+			return $strKey;
+		}
+		// Return the case-insensitive match
+		return $this->mKeyIndex->get(strtolower($strKey));
+	}
+
+	/**
+	 * This method sets the raw value of a row at a key with case-insensitivity, new keys get a column that is null for every other row
+	 * @access public
+	 * @name VariantTable::set()
+	 * @param int $intRow
+	 * @param string $strKey
+	 * @param mixed $mixValue
+	 * @return VariantTable $this
+	 * @throws Exception
+	 */
+	public function set(int $intRow, string $strKey, mixed $mixValue) : VariantTable
+	{
+		// Make sure the row exists
+		if (($intRow < 0) || ($intRow >= $this->mCount)) {
+			// Throw an exception
+			throw new Exception('VariantTable has no row '.$intRow.'.');
+		}
+		// Grab the column
+		$vecColumn = $this->columnOf($strKey);
+		// Check for a new column
+		if ($vecColumn === null) {
+			// Create the column with a null for each row
+			$vecColumn = Vector {};
+			$vecColumn->resize($this->mCount, null);
+			// Set the column into the instance
+			$this->mData->set($strKey, $vecColumn);
+			// Index the key, no other column folds to it or columnOf() would have found it
+			$this->mKeyIndex->set(strtolower($strKey), $strKey);
+		}
+		// Set the raw value
+		$vecColumn->set($intRow, (($mixValue instanceof Variant) ? $mixValue->getData() : $mixValue));
+		// The data has changed
+		$this->invalidate();
+		// We're done
+		return $this;
+	}
+
+	/**
+	 * This method returns a new table with the rows at the specified indices, in that order
+	 * @access public
+	 * @name VariantTable::select()
+	 * @param HH\Vector<int> $vecRows
+	 * @return VariantTable
+	 */
+	public function select(Vector<int> $vecRows) : VariantTable
+	{
+		// Create the response table
+		$vtbReturn = new VariantTable();
+		// Iterate over the columns
+		foreach ($this->mData->getIterator() as $strKey => $vecColumn) {
+			// Create the new column
+			$vecSelected = Vector {};
+			// Reserve the rows
+			$vecSelected->reserve($vecRows->count());
+			// Iterate over the rows
+			foreach ($vecRows->getIterator() as $intRow) {
+				// Add the value
+				$vecSelected->add($vecColumn->at($intRow));
+			}
+			// Set the column into the response table
+			$vtbReturn->mData->set($strKey, $vecSelected);
+		}
+		// Share the key index and set the row count
+		$vtbReturn->mKeyIndex = $this->mKeyIndex->toMap();
+		$vtbReturn->mCount    = $vecRows->count();
+		// We're done
+		return $vtbReturn;
+	}
+
+	//////////////////////////////////////////////////////////////////////////////
+	/// Converters //////////////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////
+
+	/**
+	 * This method returns the rows as a sequential array of associative arrays with the values as their original type
+	 * @access public
+	 * @name VariantTable::toArray()
+	 * @return array<array<string, mixed>>
+	 */
+	public function toArray() : array<array<string, mixed>>
+	{
+		// Create the response array
+		$arrRows = [];
+		// Iterate over the rows
+		for ($intRow = 0; $intRow < $this->mCount; ++$intRow) {
+			// Create the row
+			$arrRow = [];
+			// Iterate over the columns
+			foreach ($this->mData->getIterator() as $strKey => $vecColumn) {
+				// Set the value
+				$arrRow[$strKey] = $vecColumn->at($intRow);
+			}
+			// Add the row
+			$arrRows[] = $arrRow;
+		}
+		// We're done
+		return $arrRows;
+	}
+
+	/**
+	 * This method converts the table back to a VariantList<VariantMap>, the rows are copies that no longer write back into the table
+	 * @access public
+	 * @name VariantTable::toVariantList()
+	 * @param string $strDelimiter [,] Unused, kept for compatibility with Variant::toVariantList()
+	 * @param int $intLimit [null] Unused, kept for compatibility with Variant::toVariantList()
+	 * @return VariantList
+	 */
+	public function toVariantList(string $strDelimiter = ',', ?int $intLimit = null) : VariantList
+	{
+		// Create the response list
+		$vltReturn = new VariantList();
+		// Reserve the rows
+		$vltReturn->reserve($this->mCount);
+		// Iterate over the rows
+		for ($intRow = 0; $intRow < $this->mCount; ++$intRow) {
+			// Add the row, its values are wrapped as they are reached
+			$vltReturn->addVariant(VariantMap::Factory($this->rowOf($intRow), true));
+		}
+		// We're done
+		return $vltReturn;
+	}
+
+	//////////////////////////////////////////////////////////////////////////////
+	/// Getters /////////////////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////
+
+	/**
+	 * This method returns the rows in their original type
+	 * @access public
+	 * @name VariantTable::getData()
+	 * @return HH\Vector<HH\Map<string, mixed>>
+	 */
+	public function getData() : Vector<Map<string, mixed>>
+	{
+		// Create the response vector
+		$vecRows = Vector {};
+		// Reserve the rows
+		$vecRows->reserve($this->mCount);
+		// Iterate over the rows
+		foreach ($this->toArray() as $arrRow) {
+			// Add the row
+			$vecRows->add(new Map($arrRow));
+		}
+		// We're done
+		return $vecRows;
+	}
+
+	/**
+	 * This method returns the rows as an immutable view
+	 * @access public
+	 * @name VariantTable::getImmutableData()
+	 * @return HH\ImmVector<HH\ImmMap<string, mixed>>
+	 */
+	public function getImmutableData() : ImmVector<ImmMap<string, mixed>>
+	{
+		// Create the response vector
+		$vecRows = Vector {};
+		// Reserve the rows
+		$vecRows->reserve($this->mCount);
+		// Iterate over the rows
+		foreach ($this->toArray() as $arrRow) {
+			// Add the row
+			$vecRows->add(new ImmMap($arrRow));
+		}
+		// We're done
+		return $vecRows->toImmVector();
+	}
+
+	/**
+	 * This method returns the column names in the order they were first seen
+	 * @access public
+	 * @name VariantTable::getKeys()
+	 * @return HH\Vector<string>
+	 */
+	public function getKeys() : Vector<string>
+	{
+		// Return the keys
+		return $this->mData->keys();
+	}
+}
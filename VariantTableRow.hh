@@ -0,0 +1,134 @@
+<?hh
+
+///////////////////////////////////////////////////////////////////////////////
+/// VariantTableRow Class Definition /////////////////////////////////////////
+/////////////////////////////////////////////////////////////////////////////
+
+/**
+ * A row of a VariantTable, its values are wrapped as they are reached like any lazy VariantMap
+ * set(), setVariant(), remove() and clear() are written back into the columns of the table as well, a removed key reads back as null
+ * because the table stores a missing key as null, values changed in place, such as with Variant::replace(), only change this row
+ */
+class VariantTableRow extends VariantMap
+{
+	//////////////////////////////////////////////////////////////////////////////
+	/// Properties //////////////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////
+
+	/**
+	 * This property contains the index of the row in the table
+	 * @access protected
+	 * @name VariantTableRow::$mRow
+	 * @var int
+	 */
+	protected int $mRow             = 0;
+
+	/**
+	 * This property contains the table the row writes back into
+	 * @access protected
+	 * @name VariantTableRow::$mTable
+	 * @var VariantTable
+	 */
+	protected ?VariantTable $mTable = null;
+
+	//////////////////////////////////////////////////////////////////////////////
+	/// Constructor /////////////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////
+
+	/**
+	 * This method sets up a row of a table with its raw values
+	 * @access public
+	 * @name VariantTableRow::__construct()
+	 * @param VariantTable $vtbTable
+	 * @param int $intRow
+	 * @param HH\Map<string, mixed> $mapRow
+	 * @return void
+	 */
+	public function __construct(VariantTable $vtbTable, int $intRow, Map<string, mixed> $mapRow) : void
+	{
+		// Set the raw values into the instance, they are wrapped as they are reached
+		parent::__construct($mapRow, true);
+		// Set the table and row into the instance
+		$this->mRow   = $intRow;
+		$this->mTable = $vtbTable;
+	}
+
+	//////////////////////////////////////////////////////////////////////////////
+	/// Public Methods //////////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////
+
+	/**
+	 * This method nulls every column of the row in the table and empties out the row
+	 * @access public
+	 * @name VariantTableRow::clear()
+	 * @return VariantMap $this
+	 */
+	public function clear() : VariantMap
+	{
+		// Iterate over the columns of the table
+		foreach ($this->mTable->getKeys()->getIterator() as $strKey) {
+			// Null the value in the table
+			$this->mTable->set($this->mRow, $strKey, null);
+		}
+		// Empty out the row
+		return parent::clear();
+	}
+
+	/**
+	 * This method nulls a column of the row in the table and removes the key from the row
+	 * @access public
+	 * @name VariantTableRow::remove()
+	 * @param string $strKey
+	 * @return VariantMap $this
+	 */
+	public function remove(string $strKey) : VariantMap
+	{
+		// Resolve the key
+		$strRealKey = $this->search($strKey);
+		// Check for the key
+		if ($strRealKey === null) {
+			// We're done
+			return $this;
+		}
+		// Null the value in the table
+		$this->mTable->set($this->mRow, $strRealKey, null);
+		// Remove the key from the row
+		return parent::remove($strRealKey);
+	}
+
+	/**
+	 * This method sets a value into the row and its column in the table, new keys add a column to the table
+	 * @access public
+	 * @name VariantTableRow::set()
+	 * @param string $strKey
+	 * @param mixed $mixValue
+	 * @return VariantMap $this
+	 */
+	public function set(string $strKey, mixed $mixValue) : VariantMap
+	{
+		// Resolve the key, so a key in another case changes the existing column
+		$strRealKey = ($this->search($strKey) ?? $strKey);
+		// Write the value into the table
+		$this->mTable->set($this->mRow, $strRealKey, $mixValue);
+		// Set the value into the row
+		return parent::set($strRealKey, $mixValue);
+	}
+
+	/**
+	 * This method sets an existing Variant into the row without copying it, and its raw value into the column in the table
+	 * @access public
+	 * @name VariantTableRow::setVariant()
+	 * @param string $strKey
+	 * @param Variant $varValue
+	 * @return VariantMap $this
+	 */
+	public function setVariant(string $strKey, Variant $varValue) : VariantMap
+	{
+		// Resolve the key, so a key in another case changes the existing column
+		$strRealKey = ($this->search($strKey) ?? $strKey);
+		// Write the raw value into the table
+		$this->mTable->set($this->mRow, $strRealKey, $varValue->getData());
+		// Set the Variant into the row
+		return parent::setVariant($strRealKey, $varValue);
+	}
+}
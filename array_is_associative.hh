@@ -1,13 +1,29 @@
 <?hh
 
 /**
- * This method checks an array to see if it is associative or numerically indexed
+ * This method checks an array to see if it is associative or numerically indexed, it stops at the first key that decides it
  * @name array_is_associative()
  * @param array<mixed> $arrTest
+ * @param bool $blnStrict [false] Also treat integer keys that are not sequential from zero as associative
  * @return bool
  */
-function array_is_associative(array<mixed, mixed> $arrTest) : bool
+function array_is_associative(array<mixed, mixed> $arrTest, bool $blnStrict = false) : bool
 {
+	// Localize the next sequential index
+	$intExpected = 0;
+	// Iterate over the keys
+	foreach ($arrTest as $mixKey => $mixValue) {
+		// Check for a string key
+		if (is_string($mixKey)) {
+			// We're done
+			return true;
+		}
+		// Check for a gap in the sequence
+		if ($blnStrict && ($mixKey !== $intExpected++)) {
+			// We're done
+			return true;
+		}
+	}
 	// Return the associative status
-	return (bool) count(array_filter(array_keys($arrTest), 'is_string'));
+	return false;
 }
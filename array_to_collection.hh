@@ -8,19 +8,49 @@ require_once('array_to_map.hh');
 require_once('array_to_vector.hh');
 
 /**
- * This method converts an array to a collection type of either a Vector or a Map
+ * This method converts an array to a collection type of either a Vector or a Map, nested arrays are converted with a work list instead of recursion
  * @name array_to_collection()
  * @param array<mixed, mixed> $arrSource
+ * @param bool $blnAssociative [null] Force the root to a Map (true) or a Vector (false) instead of checking it
  * @return Map<string, mixed>|Vector<mixed>
  */
-function array_to_collection(array $arrSource) : mixed
+function array_to_collection(array $arrSource, ?bool $blnAssociative = null) : mixed
 {
-	// Check for an associative array
-	if (array_is_associative($arrSource) === true) {
-		// Return the data
-		return array_to_map($arrSource);
-	} else {
-		// Return the data
-		return array_to_vector($arrSource);
+	// Create the root collection
+	$colReturn = (($blnAssociative ?? array_is_associative($arrSource)) ? Map {} : Vector {});
+	// Reserve the root
+	$colReturn->reserve(count($arrSource));
+	// Create the work list of arrays still to copy into their collections
+	$vecStack  = Vector { Pair { $arrSource, $colReturn } };
+	// Iterate until the work list is empty
+	while ($vecStack->isEmpty() === false) {
+		// Grab the next array and its collection
+		list($arrData, $colTarget) = $vecStack->pop();
+		// Check the target type once
+		$blnMap = ($colTarget instanceof Map);
+		// Iterate over the array
+		foreach ($arrData as $mixKey => $mixValue) {
+			// Check for a nested array
+			if (is_array($mixValue)) {
+				// Classify the nested array exactly once
+				$colChild = (array_is_associative($mixValue) ? Map {} : Vector {});
+				// Reserve the nested collection
+				$colChild->reserve(count($mixValue));
+				// Queue the nested array, its collection is filled in later
+				$vecStack->add(Pair { $mixValue, $colChild });
+				// Set the nested collection in place of the array
+				$mixValue = $colChild;
+			}
+			// Check the target type
+			if ($blnMap) {
+				// Set the value
+				$colTarget->set($mixKey, $mixValue);
+			} else {
+				// Set the value
+				$colTarget->add($mixValue);
+			}
+		}
 	}
+	// Return the data
+	return $colReturn;
 }
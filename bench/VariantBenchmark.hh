@@ -0,0 +1,232 @@
+<?hh
+
+///////////////////////////////////////////////////////////////////////////////
+/// VariantBenchmark Class Definition ////////////////////////////////////////
+/////////////////////////////////////////////////////////////////////////////
+
+/**
+ * A small benchmark harness, each case is warmed up, timed over a number of repetitions and reported with its median, p95 and the memory its result holds
+ * Inputs are built by a setup callable outside of the timed region, so only the case itself is measured
+ */
+class VariantBenchmark
+{
+	//////////////////////////////////////////////////////////////////////////////
+	/// Properties //////////////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////
+
+	/**
+	 * This property contains a substring a case name must contain to run, an empty string runs every case
+	 * @access protected
+	 * @name VariantBenchmark::$mFilter
+	 * @var string
+	 */
+	protected string $mFilter                       = '';
+
+	/**
+	 * This property contains the number of timed runs of each case
+	 * @access protected
+	 * @name VariantBenchmark::$mRepetitions
+	 * @var int
+	 */
+	protected int $mRepetitions                     = 15;
+
+	/**
+	 * This property contains the results of every case that has run
+	 * @access protected
+	 * @name VariantBenchmark::$mResults
+	 * @var HH\Vector<HH\Map<string, mixed>>
+	 */
+	protected Vector<Map<string, mixed>> $mResults  = Vector {};
+
+	/**
+	 * This property contains the number of untimed runs of each case before the timed ones
+	 * @access protected
+	 * @name VariantBenchmark::$mWarmup
+	 * @var int
+	 */
+	protected int $mWarmup                          = 3;
+
+	//////////////////////////////////////////////////////////////////////////////
+	/// Constructor /////////////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////
+
+	/**
+	 * This method sets up the harness
+	 * @access public
+	 * @name VariantBenchmark::__construct()
+	 * @param int $intRepetitions [15]
+	 * @param int $intWarmup [3]
+	 * @param string $strFilter ['']
+	 * @return void
+	 */
+	public function __construct(int $intRepetitions = 15, int $intWarmup = 3, string $strFilter = '') : void
+	{
+		// Set the settings into the instance
+		$this->mRepetitions = max(1, $intRepetitions);
+		$this->mWarmup      = max(0, $intWarmup);
+		$this->mFilter      = $strFilter;
+		// Create the results
+		$this->mResults     = Vector {};
+	}
+
+	//////////////////////////////////////////////////////////////////////////////
+	/// Static Constructor //////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////
+
+	/**
+	 * This method instantiates and sets up the harness
+	 * @access public
+	 * @name VariantBenchmark::Factory()
+	 * @param int $intRepetitions [15]
+	 * @param int $intWarmup [3]
+	 * @param string $strFilter ['']
+	 * @return VariantBenchmark
+	 * @static
+	 */
+	public static function Factory(int $intRepetitions = 15, int $intWarmup = 3, string $strFilter = '') : VariantBenchmark
+	{
+		// Return the new instance
+		return new self($intRepetitions, $intWarmup, $strFilter);
+	}
+
+	//////////////////////////////////////////////////////////////////////////////
+	/// Protected Static Methods ////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////
+
+	/**
+	 * This method returns the value at a percentile of a sorted list using the nearest rank
+	 * @access protected
+	 * @name VariantBenchmark::percentile()
+	 * @param array<num> $arrSorted
+	 * @param int $intPercentile
+	 * @return num
+	 * @static
+	 */
+	protected static function percentile(array<num> $arrSorted, int $intPercentile) : num
+	{
+		// Localize the rank
+		$intRank = (int) ceil((count($arrSorted) * $intPercentile) / 100);
+		// Return the value
+		return $arrSorted[max(0, ($intRank - 1))];
+	}
+
+	//////////////////////////////////////////////////////////////////////////////
+	/// Public Methods //////////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////
+
+	/**
+	 * This method runs a case, $fnSetup builds its input once and $fnCase is timed with that input
+	 * The memory reported is what the result of the case still holds once it returns, which is the cost of the structure it built
+	 * @access public
+	 * @name VariantBenchmark::run()
+	 * @param string $strName
+	 * @param int $intSize The number of elements the case works on, used to report the time per element
+	 * @param callable $fnSetup
+	 * @param callable $fnCase
+	 * @return VariantBenchmark $this
+	 */
+	public function run(string $strName, int $intSize, callable $fnSetup, callable $fnCase) : VariantBenchmark
+	{
+		// Check the filter
+		if (($this->mFilter !== '') && (strpos($strName, $this->mFilter) === false)) {
+			// We're done
+			return $this;
+		}
+		// Build the input
+		$mixInput = $fnSetup();
+		// Iterate over the warmup runs
+		for ($intRun = 0; $intRun < $this->mWarmup; ++$intRun) {
+			// Run the case and drop the result
+			$fnCase($mixInput);
+		}
+		// Create the samples
+		$arrTimes  = [];
+		$arrMemory = [];
+		// Iterate over the timed runs
+		for ($intRun = 0; $intRun < $this->mRepetitions; ++$intRun) {
+			// Start from a clean heap
+			gc_collect_cycles();
+			// Localize the memory and time before the run
+			$intMemory = memory_get_usage();
+			$fltStart  = microtime(true);
+			// Run the case, the result is kept so its memory can be measured
+			$mixResult = $fnCase($mixInput);
+			// Record the time in microseconds and the memory the result holds
+			$arrTimes[]  = ((microtime(true) - $fltStart) * 1000000);
+			$arrMemory[] = (memory_get_usage() - $intMemory);
+			// Drop the result
+			$mixResult = null;
+		}
+		// Sort the samples
+		sort($arrTimes);
+		sort($arrMemory);
+		// Localize the median time
+		$fltMedian = self::percentile($arrTimes, 50);
+		// Add the result
+		$this->mResults->add(Map {
+			'name'          => $strName,
+			'size'          => $intSize,
+			'repetitions'   => $this->mRepetitions,
+			'warmup'        => $this->mWarmup,
+			'median_us'     => round($fltMedian, 3),
+			'p95_us'        => round(self::percentile($arrTimes, 95), 3),
+			'min_us'        => round($arrTimes[0], 3),
+			'mean_us'       => round((array_sum($arrTimes) / count($arrTimes)), 3),
+			'per_item_ns'   => round((($fltMedian * 1000) / max(1, $intSize)), 3),
+			'memory_bytes'  => self::percentile($arrMemory, 50),
+			'peak_bytes'    => memory_get_peak_usage()
+		});
+		// Report the progress on stderr, stdout may hold the results
+		fwrite(STDERR, sprintf("%-60s %12.1f us  p95 %12.1f us  %12d B\n", $strName, $fltMedian, self::percentile($arrTimes, 95), self::percentile($arrMemory, 50)));
+		// We're done
+		return $this;
+	}
+
+	//////////////////////////////////////////////////////////////////////////////
+	/// Converters //////////////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////
+
+	/**
+	 * This method returns the results and the environment they were measured in as JSON
+	 * @access public
+	 * @name VariantBenchmark::toJson()
+	 * @return string
+	 */
+	public function toJson() : string
+	{
+		// Return the report
+		return json_encode([
+			'meta'    => [
+				'hhvm'        => (defined('HHVM_VERSION') ? HHVM_VERSION : PHP_VERSION),
+				'host'        => php_uname(),
+				'time'        => date('c'),
+				'repetitions' => $this->mRepetitions,
+				'warmup'      => $this->mWarmup
+			],
+			'results' => $this->getResults()->toArray()
+		], JSON_PRETTY_PRINT);
+	}
+
+	//////////////////////////////////////////////////////////////////////////////
+	/// Getters /////////////////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////
+
+	/**
+	 * This method returns the results of every case that has run
+	 * @access public
+	 * @name VariantBenchmark::getResults()
+	 * @return HH\Vector<array<string, mixed>>
+	 */
+	public function getResults() : Vector<array<string, mixed>>
+	{
+		// Create the response vector
+		$vecResults = Vector {};
+		// Iterate over the results
+		foreach ($this->mResults->getIterator() as $mapResult) {
+			// Add the result as an array
+			$vecResults->add($mapResult->toArray());
+		}
+		// We're done
+		return $vecResults;
+	}
+}
@@ -0,0 +1,381 @@
+<?hh
+
+/**
+ * Needed Libraries
+ */
+require_once(__DIR__.'/../array_is_associative.hh');
+require_once(__DIR__.'/../array_to_collection.hh');
+require_once(__DIR__.'/../Variant.hh');
+require_once(__DIR__.'/../VariantList.hh');
+require_once(__DIR__.'/../VariantMap.hh');
+require_once(__DIR__.'/../SchemaVariant.hh');
+require_once(__DIR__.'/../SchemaVariantMap.hh');
+require_once(__DIR__.'/../VariantBinary.hh');
+require_once(__DIR__.'/../VariantJsonWriter.hh');
+require_once(__DIR__.'/../VariantPool.hh');
+require_once(__DIR__.'/../VariantSchema.hh');
+require_once(__DIR__.'/../VariantSqlBuilder.hh');
+require_once(__DIR__.'/../VariantStats.hh');
+require_once(__DIR__.'/../VariantTable.hh');
+require_once(__DIR__.'/../VariantTableRow.hh');
+require_once(__DIR__.'/VariantBenchmark.hh');
+
+/**
+ * This method builds synthetic database rows with $intColumns mixed columns, "group" cycles through 100 values
+ * @name bench_rows()
+ * @param int $intRows
+ * @param int $intColumns
+ * @return array<array<string, mixed>>
+ */
+function bench_rows(int $intRows, int $intColumns) : array<array<string, mixed>>
+{
+	// Create the rows
+	$arrRows = [];
+	// Iterate over the rows
+	for ($intRow = 0; $intRow < $intRows; ++$intRow) {
+		// Create the row with its key columns
+		$arrRow = ['id' => $intRow, 'group' => 'group_'.($intRow % 100)];
+		// Iterate over the remaining columns
+		for ($intColumn = 2; $intColumn < $intColumns; ++$intColumn) {
+			// Mix integers, floats, strings, booleans and nulls like a real result set
+			switch ($intColumn % 5) {
+				case 0  : $arrRow['Column'.$intColumn] = ($intRow * $intColumn);         break;
+				case 1  : $arrRow['Column'.$intColumn] = ($intRow / ($intColumn + 1));   break;
+				case 2  : $arrRow['Column'.$intColumn] = "O'Value ".$intRow;             break;
+				case 3  : $arrRow['Column'.$intColumn] = (($intRow % 2) === 0);          break;
+				default : $arrRow['Column'.$intColumn] = ((($intRow % 7) === 0) ? null : 'v'.$intColumn);
+			}
+		}
+		// Add the row
+		$arrRows[] = $arrRow;
+	}
+	// We're done
+	return $arrRows;
+}
+
+/**
+ * This method registers the schema of the rows bench_rows() builds with $intColumns columns
+ * @name bench_schema()
+ * @param int $intColumns
+ * @return VariantSchema
+ */
+function bench_schema(int $intColumns) : VariantSchema
+{
+	// Create the schema with its key columns
+	$vscSchema = VariantSchema::Factory('bench_rows_'.$intColumns)
+		->column('id', Type::VInteger, false)
+		->column('group', Type::VString, false);
+	// Iterate over the remaining columns
+	for ($intColumn = 2; $intColumn < $intColumns; ++$intColumn) {
+		// Declare the column like bench_rows() fills it
+		switch ($intColumn % 5) {
+			case 0  : $vscSchema->column('Column'.$intColumn, Type::VInteger, false); break;
+			case 1  : $vscSchema->column('Column'.$intColumn, Type::VDouble, false);  break;
+			case 2  : $vscSchema->column('Column'.$intColumn, Type::VString, false);  break;
+			case 3  : $vscSchema->column('Column'.$intColumn, Type::VBoolean, false); break;
+			default : $vscSchema->column('Column'.$intColumn, Type::VString);
+		}
+	}
+	// We're done
+	return $vscSchema;
+}
+
+/**
+ * This method builds $intChains nested chains that are $intDepth levels deep
+ * @name bench_deep()
+ * @param int $intChains
+ * @param int $intDepth
+ * @return array<mixed>
+ */
+function bench_deep(int $intChains, int $intDepth) : array<mixed>
+{
+	// Create the chains
+	$arrChains = [];
+	// Iterate over the chains
+	for ($intChain = 0; $intChain < $intChains; ++$intChain) {
+		// Start with the leaf
+		$arrNode = ['leaf' => $intChain, 'list' => [1, 2, 3]];
+		// Iterate over the levels
+		for ($intLevel = 0; $intLevel < $intDepth; ++$intLevel) {
+			// Wrap the node
+			$arrNode = ['level' => $intLevel, 'child' => $arrNode];
+		}
+		// Add the chain
+		$arrChains[] = $arrNode;
+	}
+	// We're done
+	return $arrChains;
+}
+
+/**
+ * This method returns one sample value for each type Variant detects
+ * @name bench_samples()
+ * @return HH\Map<string, mixed>
+ */
+function bench_samples() : Map<string, mixed>
+{
+	// Return the samples
+	return Map {
+		'array'   => [1, 2, 3],
+		'boolean' => true,
+		'double'  => 3.25,
+		'integer' => 42,
+		'json'    => '{"id":1,"name":"json"}',
+		'map'     => Map {'a' => 1, 'b' => 2},
+		'null'    => null,
+		'object'  => (object) ['a' => 1],
+		'pair'    => Pair {1, 2},
+		'set'     => Set {1, 2, 3},
+		'string'  => 'hello world',
+		'vector'  => Vector {1, 2, 3}
+	};
+}
+
+/**
+ * This method parses the --name=value options of the runner
+ * @name bench_options()
+ * @param array<string> $arrArguments
+ * @return HH\Map<string, string>
+ */
+function bench_options(array<string> $arrArguments) : Map<string, string>
+{
+	// Create the defaults
+	$mapOptions = Map {
+		'filter'      => '',
+		'output'      => '',
+		'repetitions' => '15',
+		'sizes'       => '1000,100000',
+		'table-rows'  => '100000',
+		'warmup'      => '3'
+	};
+	// Iterate over the arguments
+	foreach ($arrArguments as $strArgument) {
+		// Check for an option
+		if (preg_match('/^--([a-z-]+)=(.*)$/', $strArgument, $arrMatch)) {
+			// Set the option
+			$mapOptions->set($arrMatch[1], $arrMatch[2]);
+		}
+	}
+	// We're done
+	return $mapOptions;
+}
+
+/**
+ * This method runs every benchmark, usage: hhvm bench/run.hh [--sizes=1000,100000] [--repetitions=15] [--warmup=3] [--table-rows=100000] [--filter=name] [--output=file.json]
+ * @name bench_main()
+ * @param array<string> $arrArguments
+ * @return void
+ */
+function bench_main(array<string> $arrArguments) : void
+{
+	// Localize the options
+	$mapOptions = bench_options($arrArguments);
+	$arrSizes   = array_map('intval', explode(',', $mapOptions->at('sizes')));
+	$intSmall   = min($arrSizes);
+	// Create the harness
+	$bchRun     = VariantBenchmark::Factory((int) $mapOptions->at('repetitions'), (int) $mapOptions->at('warmup'), $mapOptions->at('filter'));
+
+	// Variant::Factory() for each kind of input
+	foreach ($arrSizes as $intSize) {
+		// Scalars
+		$bchRun->run('factory/scalar', $intSize, () ==> range(1, $intSize), function(array $arrInput) {
+			$vecOut = Vector {};
+			foreach ($arrInput as $intValue) {
+				$vecOut->add(Variant::Factory($intValue));
+			}
+			return $vecOut;
+		});
+		// Scalars through the interning pool
+		$bchRun->run('factory/scalar-interned', $intSize, function() use ($intSize) {
+			VariantPool::reset();
+			return array_map(($intValue) ==> ($intValue % 64), range(1, $intSize));
+		}, function(array $arrInput) {
+			VariantPool::enable();
+			$vecOut = Vector {};
+			foreach ($arrInput as $intValue) {
+				$vecOut->add(Variant::Factory($intValue));
+			}
+			VariantPool::disable();
+			return $vecOut;
+		});
+		// Associative rows
+		$bchRun->run('factory/row-20', $intSize, () ==> bench_rows($intSize, 20), function(array $arrInput) {
+			$vecOut = Vector {};
+			foreach ($arrInput as $arrRow) {
+				$vecOut->add(Variant::Factory($arrRow));
+			}
+			return $vecOut;
+		});
+		$bchRun->run('factory/row-20-lazy', $intSize, () ==> bench_rows($intSize, 20), function(array $arrInput) {
+			$vecOut = Vector {};
+			foreach ($arrInput as $arrRow) {
+				$vecOut->add(Variant::Factory($arrRow, true));
+			}
+			return $vecOut;
+		});
+	}
+
+	// Variant::convert() for every convertible pair, on the smallest size
+	foreach (bench_samples()->getIterator() as $strSource => $mixSample) {
+		// Localize the source type
+		$typeSource = (new Variant($mixSample))->getType();
+		// Iterate over the targets
+		foreach (Type::getValues() as $strTarget => $typeTarget) {
+			// Check for a conversion
+			if (Variant::canConvert($typeSource, $typeTarget) === false) {
+				// Next target
+				continue;
+			}
+			// Run the conversion
+			$bchRun->run('convert/'.$strSource.'>'.$typeTarget, $intSmall, function() use ($mixSample, $intSmall) {
+				$vecInput = Vector {};
+				for ($intIndex = 0; $intIndex < $intSmall; ++$intIndex) {
+					$vecInput->add(new Variant($mixSample));
+				}
+				return $vecInput;
+			}, function(Vector<Variant> $vecInput) use ($typeTarget) {
+				foreach ($vecInput->getIterator() as $varValue) {
+					$varValue->convert($typeTarget);
+				}
+				return null;
+			});
+		}
+	}
+
+	// Per-instance memory and wide rows
+	foreach ($arrSizes as $intSize) {
+		$bchRun->run('memory/variant-instances', $intSize, () ==> range(1, $intSize), function(array $arrInput) {
+			$vecOut = Vector {};
+			foreach ($arrInput as $intValue) {
+				$vecOut->add(new Variant($intValue));
+			}
+			return $vecOut;
+		});
+		$bchRun->run('memory/list-packed-ints', $intSize, () ==> range(1, $intSize), ($arrInput) ==> VariantList::fromArray($arrInput));
+		$bchRun->run('memory/list-eager-mixed', $intSize, () ==> array_merge(range(1, $intSize - 1), [null]), ($arrInput) ==> VariantList::fromArray($arrInput));
+		$bchRun->run('memory/list-lazy-mixed', $intSize, () ==> array_merge(range(1, $intSize - 1), [null]), ($arrInput) ==> VariantList::fromArray($arrInput, true));
+		// VariantMap construction from wide rows
+		foreach ([40, 60] as $intColumns) {
+			$bchRun->run('map/construct-wide-'.$intColumns, $intSize, () ==> bench_rows($intSize, $intColumns), function(array $arrInput) {
+				$vecOut = Vector {};
+				foreach ($arrInput as $arrRow) {
+					$vecOut->add(VariantMap::fromArray($arrRow));
+				}
+				return $vecOut;
+			});
+		}
+	}
+
+	// VariantMap::search() hits, case-folded hits and misses
+	foreach ($arrSizes as $intSize) {
+		foreach (Map {'hit' => 'Column17', 'fold' => 'COLUMN17', 'miss' => 'NoSuchColumn'} as $strCase => $strKey) {
+			$bchRun->run('map/search-'.$strCase, $intSize, () ==> VariantMap::fromArray(bench_rows(1, 60)[0]), function(VariantMap $varMap) use ($intSize, $strKey) {
+				for ($intIndex = 0; $intIndex < $intSize; ++$intIndex) {
+					$varMap->search($strKey);
+				}
+				return null;
+			});
+		}
+	}
+
+	// SchemaVariantMap against VariantMap, memory per row and get() latency
+	foreach ($arrSizes as $intSize) {
+		$bchRun->run('schema/construct-wide-40', $intSize, () ==> Pair {bench_schema(40), bench_rows($intSize, 40)}, function(Pair<VariantSchema, array> $parInput) {
+			$vecOut = Vector {};
+			foreach ($parInput[1] as $arrRow) {
+				$vecOut->add($parInput[0]->map($arrRow));
+			}
+			return $vecOut;
+		});
+		foreach (Map {'map' => false, 'schema' => true} as $strCase => $blnSchema) {
+			$bchRun->run('schema/get-'.$strCase, $intSize, function() use ($blnSchema) {
+				$arrRow = bench_rows(1, 40)[0];
+				return ($blnSchema ? bench_schema(40)->map($arrRow) : VariantMap::fromArray($arrRow));
+			}, function(VariantMap $varMap) use ($intSize) {
+				for ($intIndex = 0; $intIndex < $intSize; ++$intIndex) {
+					$varMap->get('Column17')->toString();
+				}
+				return null;
+			});
+		}
+	}
+
+	// VariantList::implode(), groupedVariantMap() and hasDuplicates()
+	foreach ($arrSizes as $intSize) {
+		$bchRun->run('list/implode-mysql-strings', $intSize, () ==> VariantList::fromArray(array_map(($intValue) ==> "O'Brien ".$intValue, range(1, $intSize))), ($vltInput) ==> $vltInput->implode(',', true));
+		$bchRun->run('list/implode-mysql-ints', $intSize, () ==> VariantList::fromArray(range(1, $intSize)), ($vltInput) ==> $vltInput->implode(',', true));
+		$bchRun->run('list/grouped-variant-map', $intSize, () ==> VariantList::fromArray(bench_rows($intSize, 10)), ($vltInput) ==> $vltInput->groupedVariantMap('group'));
+		$bchRun->run('list/has-duplicates-loose-unique-ints', $intSize, () ==> VariantList::fromArray(range(1, $intSize)), ($vltInput) ==> $vltInput->hasDuplicates());
+		$bchRun->run('list/has-duplicates-loose-unique-strings', $intSize, () ==> VariantList::fromArray(array_map(($intValue) ==> 'v'.$intValue, range(1, $intSize))), ($vltInput) ==> $vltInput->hasDuplicates());
+		$bchRun->run('list/has-duplicates-strict-unique-ints', $intSize, () ==> VariantList::fromArray(range(1, $intSize)), ($vltInput) ==> $vltInput->hasDuplicates(true));
+		$bchRun->run('list/has-duplicates-strict-unique-strings', $intSize, () ==> VariantList::fromArray(array_map(($intValue) ==> 'v'.$intValue, range(1, $intSize))), ($vltInput) ==> $vltInput->hasDuplicates(true));
+	}
+
+	// VariantList::convertAll() against a toInt() call per value, on 1M homogeneous and mixed values
+	foreach (Map {'packed-ints' => false, 'mixed' => true} as $strCase => $blnMixed) {
+		$fnSetup = () ==> VariantList::fromArray(array_map(($intValue) ==> (($blnMixed && (($intValue % 8) === 0)) ? (string) $intValue : $intValue), range(1, 1000000)));
+		$bchRun->run('list/convert-all-int-'.$strCase, 1000000, $fnSetup, ($vltInput) ==> $vltInput->convertAll(Type::VInteger));
+		$bchRun->run('list/convert-each-int-'.$strCase, 1000000, $fnSetup, function(VariantList $vltInput) {
+			$vecOut = Vector {};
+			foreach ($vltInput->getIterator() as $varValue) {
+				$vecOut->add($varValue->toInt());
+			}
+			return $vecOut;
+		});
+		$bchRun->run('list/to-string-list-'.$strCase, 1000000, $fnSetup, ($vltInput) ==> $vltInput->toStringList());
+		$bchRun->run('list/to-float-list-'.$strCase, 1000000, $fnSetup, ($vltInput) ==> $vltInput->toFloatList());
+		$bchRun->run('list/to-json-list-'.$strCase, 1000000, $fnSetup, ($vltInput) ==> $vltInput->toJsonList());
+	}
+
+	// array_is_associative() on 1, 1k and 1M elements, sequential keys scan everything and a string key exits early
+	foreach ([1, 1000, 1000000] as $intSize) {
+		$bchRun->run('array/is-associative-sequential', $intSize, () ==> range(1, $intSize), ($arrInput) ==> array_is_associative($arrInput));
+		$bchRun->run('array/is-associative-strict', $intSize, () ==> range(1, $intSize), ($arrInput) ==> array_is_associative($arrInput, true));
+		$bchRun->run('array/is-associative-string-key', $intSize, () ==> array_merge(['key' => 0], range(1, $intSize)), ($arrInput) ==> array_is_associative($arrInput));
+	}
+
+	// array_to_collection() on shallow and deep inputs
+	foreach ($arrSizes as $intSize) {
+		$bchRun->run('array/to-collection-shallow', $intSize, () ==> bench_rows($intSize, 10), ($arrInput) ==> array_to_collection($arrInput));
+		$bchRun->run('array/to-collection-deep-50', $intSize, () ==> bench_deep(max(1, (int) ($intSize / 50)), 50), ($arrInput) ==> array_to_collection($arrInput));
+	}
+
+	// VariantBinary against serialize(), json_encode() and fb_compact_serialize()
+	foreach ($arrSizes as $intSize) {
+		$bchRun->run('encode/variant-binary', $intSize, () ==> Variant::Factory(bench_rows($intSize, 10)), ($varInput) ==> VariantBinary::encode($varInput));
+		$bchRun->run('encode/serialize', $intSize, () ==> bench_rows($intSize, 10), ($arrInput) ==> serialize($arrInput));
+		$bchRun->run('encode/json-encode', $intSize, () ==> bench_rows($intSize, 10), ($arrInput) ==> json_encode($arrInput));
+		$bchRun->run('decode/variant-binary', $intSize, () ==> VariantBinary::encode(Variant::Factory(bench_rows($intSize, 10))), ($strInput) ==> VariantBinary::decode($strInput));
+		$bchRun->run('decode/unserialize', $intSize, () ==> serialize(bench_rows($intSize, 10)), ($strInput) ==> unserialize($strInput));
+		$bchRun->run('decode/json-decode', $intSize, () ==> json_encode(bench_rows($intSize, 10)), ($strInput) ==> json_decode($strInput, true));
+		// Check for the compact serializer
+		if (function_exists('fb_compact_serialize')) {
+			$bchRun->run('encode/fb-compact-serialize', $intSize, () ==> bench_rows($intSize, 10), ($arrInput) ==> fb_compact_serialize($arrInput));
+			$bchRun->run('decode/fb-compact-unserialize', $intSize, () ==> fb_compact_serialize(bench_rows($intSize, 10)), ($strInput) ==> fb_compact_unserialize($strInput));
+		}
+	}
+
+	// VariantTable against VariantList<VariantMap>, memory and column scans
+	$intRows = (int) $mapOptions->at('table-rows');
+	$bchRun->run('table/memory-variant-list', $intRows, () ==> bench_rows($intRows, 40), ($arrInput) ==> VariantList::fromArray($arrInput));
+	$bchRun->run('table/memory-variant-table', $intRows, () ==> bench_rows($intRows, 40), ($arrInput) ==> VariantTable::Factory($arrInput));
+	$bchRun->run('table/scan-sum-variant-list', $intRows, () ==> VariantList::fromArray(bench_rows($intRows, 40)), ($vltInput) ==> array_sum($vltInput->column('id')->toArray()));
+	$bchRun->run('table/scan-sum-variant-table', $intRows, () ==> VariantTable::Factory(bench_rows($intRows, 40)), ($vtbInput) ==> array_sum($vtbInput->column('id')->toArray()));
+	$bchRun->run('table/filter-variant-table', $intRows, () ==> VariantTable::Factory(bench_rows($intRows, 40)), ($vtbInput) ==> $vtbInput->filter('Column3', ($blnValue) ==> ($blnValue === true)));
+	$bchRun->run('table/group-variant-list', $intRows, () ==> VariantList::fromArray(bench_rows($intRows, 40)), ($vltInput) ==> $vltInput->groupedVariantMap('group'));
+	$bchRun->run('table/group-variant-table', $intRows, () ==> VariantTable::Factory(bench_rows($intRows, 40)), ($vtbInput) ==> $vtbInput->group('group'));
+
+	// Localize the report
+	$strReport = $bchRun->toJson();
+	// Check for an output file
+	if ($mapOptions->at('output') !== '') {
+		// Write the report
+		file_put_contents($mapOptions->at('output'), $strReport);
+	} else {
+		// Print the report
+		echo $strReport, PHP_EOL;
+	}
+}
+
+// Run the benchmarks
+bench_main(array_slice($GLOBALS['argv'], 1));
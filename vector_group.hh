@@ -23,13 +23,18 @@ function vector_group(Vector<mixed> $vecSource, string $strKey) : Map<mixed, Vec
 			// Convert it
 			$mixValue = array_to_collection($mixValue);
 		}
-		// Check for a key in the map
-		if ($mapReturn->contains($mixValue->get($strKey)) === false) {
-			// Create the key
-			$mapReturn->set($mixValue->get($strKey), Vector {});
+		// Grab the group for the key, reading the key once
+		$mixGroup = $mixValue->get($strKey);
+		$vecGroup = $mapReturn->get($mixGroup);
+		// Check for a new group
+		if ($vecGroup === null) {
+			// Create the group
+			$vecGroup = Vector {};
+			// Set the group into the map
+			$mapReturn->set($mixGroup, $vecGroup);
 		}
 		// Set the value
-		$mapReturn->get($mixValue->get($strKey))->add($mixValue);
+		$vecGroup->add($mixValue);
 	}
 	// Return the map
 	return $mapReturn;